@@ -29,6 +29,11 @@ def test():
     )  # surface_1_tri, surface_1_verts, surface_2_tri, surface_2_verts
     # )
     print(surface_clipped)
+    for report in loop_cgal.drain_memory_reports():
+        phases = ", ".join(
+            f"{phase['name']} {phase['peak'] / 2**20:.1f}" for phase in report["phases"]
+        )
+        print(f"{report['call']}: peak {report['peak'] / 2**20:.1f} MiB ({phases})")
     # print(mesh.vertices.shape)
     # print(surface_1_verts.shape)
     # print(mesh.triangles)
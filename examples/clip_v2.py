@@ -3,7 +3,7 @@ import numpy as np
 import pyvista as pv
 from LoopStructural.datatypes import BoundingBox
 loop_cgal.set_verbose(True)
-print(loop_cgal.verbose)  # Should print True
+print(loop_cgal.get_log_level())  # Should print LogLevel.DEBUG
 def test():
     bb = BoundingBox(np.zeros(3), np.ones(3))
     grid = bb.structured_grid().vtk()
@@ -1,27 +1,189 @@
 from __future__ import annotations
 
-from typing import Tuple
+import logging
+import sys
+import types
+import warnings
+from typing import List, Optional, Tuple, Union
 
 import numpy as np
 import pyvista as pv
 
-from ._loop_cgal import NumpyMesh, NumpyPlane, clip_plane, clip_surface, corefine_mesh
+from ._loop_cgal import NumpyMesh, NumpyPlane, clip_plane, clip_surface, corefine_mesh, partition_surface
 from ._loop_cgal import TriMesh as _TriMesh
-from ._loop_cgal import verbose
+from ._loop_cgal import LogLevel, drain_log, dropped_log_records, get_log_level, set_log_level
+from ._loop_cgal import get_stderr_level, set_stderr_level
+from ._loop_cgal import ValidationLevel, get_validation_level, set_validation_level
+from ._loop_cgal import IndexType, get_index_type, set_index_type
+from ._loop_cgal import FaceLayout, get_face_layout, set_face_layout
+from ._loop_cgal import NumpyPolylines, get_num_threads, set_num_threads, slice_planes
+from ._loop_cgal import intersection_curves
+from ._loop_cgal import get_spatial_ordering, set_spatial_ordering
+from ._loop_cgal import clear_remesh_cache, remesh_cache_stats, set_remesh_cache_budget
+from ._loop_cgal import CancelledError, CancelToken
+from ._loop_cgal import drain_memory_reports, memory_stats, reset_memory_peak
 from ._loop_cgal import set_verbose as set_verbose
+
+
+class _Module(types.ModuleType):
+    """Keeps the old ``loop_cgal.verbose`` flag working on top of the log level."""
+
+    @property
+    def verbose(self) -> bool:
+        warnings.warn(
+            "loop_cgal.verbose is deprecated; use get_log_level()",
+            DeprecationWarning,
+            stacklevel=2,
+        )
+        return int(get_log_level()) >= int(LogLevel.DEBUG)
+
+    @verbose.setter
+    def verbose(self, value: bool) -> None:
+        warnings.warn(
+            "loop_cgal.verbose is deprecated; use set_verbose() or set_log_level()",
+            DeprecationWarning,
+            stacklevel=2,
+        )
+        set_verbose(bool(value))
+
+
+sys.modules[__name__].__class__ = _Module
+
+logger = logging.getLogger(__name__)
+
+_LOGGING_LEVELS = {
+    LogLevel.ERROR: logging.ERROR,
+    LogLevel.WARNING: logging.WARNING,
+    LogLevel.INFO: logging.INFO,
+    LogLevel.DEBUG: logging.DEBUG,
+}
+
+
+def forward_log(target: Optional[logging.Logger] = None) -> int:
+    """
+    Drain the C++ log buffer into a python logger.
+
+    Parameters
+    ----------
+    target : logging.Logger, optional
+        The logger to forward to, by default the ``loop_cgal`` logger
+
+    Returns
+    -------
+    int
+        The number of records forwarded.
+    """
+    target = logger if target is None else target
+    records = drain_log()
+    for level, message in records:
+        target.log(_LOGGING_LEVELS.get(level, logging.DEBUG), message)
+    return len(records)
+
+
+def _scalar_fields(data) -> dict:
+    """Numeric 1D arrays of a pyvista data container, as float64."""
+    fields = {}
+    for name in data.keys():
+        values = np.asarray(data[name])
+        if values.ndim == 1 and np.issubdtype(values.dtype, np.number):
+            fields[name] = values.astype(np.float64, copy=False)
+    return fields
+
+
+def _vtk_triangles(surface: pv.PolyData) -> Tuple[np.ndarray, np.ndarray]:
+    """Views of the (offsets, connectivity) arrays of the surface polygons."""
+    polys = surface.GetPolys()
+    return (
+        pv.convert_array(polys.GetOffsetsArray()),
+        pv.convert_array(polys.GetConnectivityArray()),
+    )
+
+
+def _numpy_mesh(surface: pv.PolyData, with_attributes: bool = True) -> NumpyMesh:
+    """
+    Wrap a triangulated PolyData without copying its arrays.
+
+    The points and VTK's own offsets/connectivity arrays are handed over as
+    views, whatever their dtype; the C++ side reads them in place.
+    """
+    mesh = NumpyMesh()
+    mesh.vertices = surface.points
+    mesh.offsets, mesh.triangles = _vtk_triangles(surface)
+    if with_attributes:
+        mesh.vertex_attributes = _scalar_fields(surface.point_data)
+        mesh.face_attributes = _scalar_fields(surface.cell_data)
+    return mesh
+
+
+# Export format the pyvista wrappers ask for: the only one VTK adopts as its
+# cell array without a copy. The module defaults (INT32 rows) are kept for
+# the numpy API.
+_VTK_EXPORT = {"index_type": IndexType.INT64, "face_layout": FaceLayout.OFFSETS}
+
+
+def _to_polydata(mesh: NumpyMesh) -> pv.PolyData:
+    """
+    Build a PolyData from an exported mesh, attaching its attributes.
+
+    Only a mesh exported with ``FaceLayout.OFFSETS`` and ``IndexType.INT64``
+    (``_VTK_EXPORT``) becomes the VTK cell array without any copy; the rows
+    and padded layouts, or INT32 indices, are copied by VTK.
+    """
+    offsets = np.asarray(mesh.offsets)
+    triangles = np.asarray(mesh.triangles)
+    # A read-only view of the result mesh must not become VTK's points
+    vertices = mesh.vertices
+    if not vertices.flags.writeable:
+        vertices = np.array(vertices)
+    if offsets.size and hasattr(pv.CellArray, "from_arrays"):
+        polydata = pv.PolyData()
+        polydata.points = vertices
+        polydata.SetPolys(pv.CellArray.from_arrays(offsets, triangles, deep=False))
+    elif offsets.size:
+        polydata = pv.PolyData.from_regular_faces(vertices, triangles.reshape(-1, 3))
+    elif triangles.ndim == 1:
+        polydata = pv.PolyData(vertices, triangles)
+    else:
+        polydata = pv.PolyData.from_regular_faces(vertices, triangles)
+    for name, values in mesh.vertex_attributes.items():
+        polydata.point_data[name] = values
+    for name, values in mesh.face_attributes.items():
+        polydata.cell_data[name] = values
+    return polydata
+
+
+def _polylines_to_polydata(lines: NumpyPolylines, id_name: str) -> pv.PolyData:
+    """Build a line PolyData from packed polylines, labelling each line."""
+    offsets = np.asarray(lines.offsets)
+    counts = np.diff(offsets)
+    if counts.size == 0:
+        return pv.PolyData()
+    cells = np.insert(np.arange(offsets[-1]), offsets[:-1], counts)
+    polydata = pv.PolyData(lines.vertices, lines=cells)
+    polydata.cell_data[id_name] = lines.ids
+    return polydata
+
+
 class TriMesh(_TriMesh):
     """
     A class for handling triangular meshes using CGAL.
     
     Inherits from the base TriMesh class and provides additional functionality.
     """
-    def __init__(self, surface: pv.PolyData):
-        verts = np.array(surface.points).copy()
-        triangles = surface.faces.reshape(-1, 4)[:, 1:].copy()
-        super().__init__(verts, triangles)
+    def __init__(
+        self,
+        surface: Union[pv.PolyData, NumpyMesh],
+        token: Optional[CancelToken] = None,
+    ):
+        if isinstance(surface, NumpyMesh):
+            super().__init__(surface, token=token)
+            return
+        offsets, connectivity = _vtk_triangles(surface)
+        super().__init__(surface.points, connectivity, offsets, token=token)
         
     def to_pyvista(self, area_threshold: float = 1e-6,  # this is the area threshold for the faces, if the area is smaller than this it will be removed
             duplicate_vertex_threshold: float = 1e-4,  # this is the threshold for duplicate vertices
+            token: Optional[CancelToken] = None,
             ) -> pv.PolyData:
         """
         Convert the TriMesh to a pyvista PolyData object.
@@ -31,10 +193,13 @@ class TriMesh(_TriMesh):
         pyvista.PolyData
             The converted PolyData object.
         """
-        np_mesh = self.save(area_threshold, duplicate_vertex_threshold)
-        vertices = np.array(np_mesh.vertices).copy()
-        triangles = np.array(np_mesh.triangles).copy()
-        return pv.PolyData.from_regular_faces(vertices, triangles)
+        try:
+            np_mesh = self.save(
+                area_threshold, duplicate_vertex_threshold, token=token, **_VTK_EXPORT
+            )
+        finally:
+            forward_log()
+        return _to_polydata(np_mesh)
 
 def clip_pyvista_polydata_with_plane(
     surface: pv.PolyData,
@@ -48,6 +213,8 @@ def clip_pyvista_polydata_with_plane(
     area_threshold: float = 0.0001,
     protect_constraints: bool = False,
     relax_constraints: bool = True,
+    convergence_tolerance: float = 0.01,
+    token: Optional[CancelToken] = None,
 ) -> pv.PolyData:
     """
     Clip a pyvista PolyData object with a plane using the CGAL library.
@@ -72,33 +239,46 @@ def clip_pyvista_polydata_with_plane(
         The threshold for merging duplicate vertices, by default 0.001
     area_threshold : float, optional
         The area threshold for removing small faces, by default 0.0001
-    
+    convergence_tolerance : float, optional
+        Stop remeshing once an iteration changes the vertex, face and
+        out-of-band edge counts and the edge-length mean and spread each by
+        less than this fraction, by default 0.01 (1%). 0 always runs all
+        iterations.
+    token : CancelToken, optional
+        Reports progress and allows the call to be cancelled, raising
+        CancelledError, by default None
+
     Returns
     -------
     pyvista.PolyData
-        The resulting clipped surface.
+        The resulting clipped surface. Scalar point and cell data of the
+        input surface are interpolated onto it.
     """
     surface = surface.triangulate()
-    tm = NumpyMesh()
-    tm.vertices = np.array(surface.points).copy()
-    tm.triangles = surface.faces.reshape(-1, 4)[:, 1:].copy()
+    tm = _numpy_mesh(surface)
     plane = NumpyPlane()
     plane.origin = np.asarray(plane_origin, dtype=np.float64)
     plane.normal = np.asarray(plane_normal, dtype=np.float64)
 
-    mesh = clip_plane(
-        tm,
-        plane,
-        target_edge_length=target_edge_length,
-        remesh_before_clipping=remesh_before_clipping,
-        remesh_after_clipping=remesh_after_clipping,
-        remove_degenerate_faces=remove_degenerate_faces,
-        duplicate_vertex_threshold=duplicate_vertex_threshold,
-        area_threshold=area_threshold,
-        protect_constraints=protect_constraints,
-        relax_constraints=relax_constraints,
-    )
-    return pv.PolyData.from_regular_faces(mesh.vertices, mesh.triangles)
+    try:
+        mesh = clip_plane(
+            tm,
+            plane,
+            target_edge_length=target_edge_length,
+            remesh_before_clipping=remesh_before_clipping,
+            remesh_after_clipping=remesh_after_clipping,
+            remove_degenerate_faces=remove_degenerate_faces,
+            duplicate_vertex_threshold=duplicate_vertex_threshold,
+            area_threshold=area_threshold,
+            protect_constraints=protect_constraints,
+            relax_constraints=relax_constraints,
+            convergence_tolerance=convergence_tolerance,
+            token=token,
+            **_VTK_EXPORT,
+        )
+    finally:
+        forward_log()
+    return _to_polydata(mesh)
 
 
 def clip_pyvista_polydata(
@@ -112,6 +292,9 @@ def clip_pyvista_polydata(
     area_threshold: float = 0.0001,
     protect_constraints: bool = False,
     relax_constraints: bool = True,
+    convergence_tolerance: float = 0.01,
+    region_of_interest: bool = False,
+    token: Optional[CancelToken] = None,
 ) -> pv.PolyData:
     """
     Clip two pyvista PolyData objects using the CGAL library.
@@ -122,33 +305,50 @@ def clip_pyvista_polydata(
         The first surface to be clipped.
     surface_2 : pyvista.PolyData
         The second surface to be used for clipping.
+    region_of_interest : bool, optional
+        Only remesh, clip and clean the faces near surface_2 and weld them
+        back onto the rest of surface_1, which is returned unchanged, by
+        default False. Falls back to clipping the whole surface when the
+        result would differ.
+    convergence_tolerance : float, optional
+        Stop remeshing once an iteration changes the vertex, face and
+        out-of-band edge counts and the edge-length mean and spread each by
+        less than this fraction, by default 0.01 (1%). 0 always runs all
+        iterations.
+    token : CancelToken, optional
+        Reports progress and allows the call to be cancelled, raising
+        CancelledError, by default None
 
     Returns
     -------
     pyvista.PolyData
-        The resulting clipped surface.
+        The resulting clipped surface. Scalar point and cell data of
+        surface_1 are interpolated onto it.
     """
     surface_1 = surface_1.triangulate()
     surface_2 = surface_2.triangulate()
-    tm = NumpyMesh()
-    tm.vertices = np.array(surface_1.points).copy()
-    tm.triangles = surface_1.faces.reshape(-1, 4)[:, 1:].copy()
-    clipper = NumpyMesh()
-    clipper.vertices = np.array(surface_2.points).copy()
-    clipper.triangles = surface_2.faces.reshape(-1, 4)[:, 1:].copy()
-    mesh = clip_surface(
-        tm,
-        clipper,
-        target_edge_length=target_edge_length,
-        remesh_before_clipping=remesh_before_clipping,
-        remesh_after_clipping=remesh_after_clipping,
-        remove_degenerate_faces=remove_degenerate_faces,
-        duplicate_vertex_threshold=duplicate_vertex_threshold,
-        area_threshold=area_threshold,
-        protect_constraints=protect_constraints,
-        relax_constraints=relax_constraints,
-    )
-    return pv.PolyData.from_regular_faces(mesh.vertices, mesh.triangles)
+    tm = _numpy_mesh(surface_1)
+    clipper = _numpy_mesh(surface_2, with_attributes=False)
+    try:
+        mesh = clip_surface(
+            tm,
+            clipper,
+            target_edge_length=target_edge_length,
+            remesh_before_clipping=remesh_before_clipping,
+            remesh_after_clipping=remesh_after_clipping,
+            remove_degenerate_faces=remove_degenerate_faces,
+            duplicate_vertex_threshold=duplicate_vertex_threshold,
+            area_threshold=area_threshold,
+            protect_constraints=protect_constraints,
+            relax_constraints=relax_constraints,
+            convergence_tolerance=convergence_tolerance,
+            region_of_interest=region_of_interest,
+            token=token,
+            **_VTK_EXPORT,
+        )
+    finally:
+        forward_log()
+    return _to_polydata(mesh)
 
 
 def corefine_pyvista_polydata(
@@ -160,6 +360,8 @@ def corefine_pyvista_polydata(
     number_of_iterations: int = 10,
     protect_constraints: bool = True,
     relax_constraints: bool = True,
+    convergence_tolerance: float = 0.01,
+    token: Optional[CancelToken] = None,
 ) -> Tuple[pv.PolyData, pv.PolyData]:
     """
     Corefine two pyvista PolyData objects using the CGAL library.
@@ -170,6 +372,16 @@ def corefine_pyvista_polydata(
         The first surface to be cored.
     surface_2 : pyvista.PolyData
         The second surface to be used for cording.
+    number_of_iterations : int, optional
+        Upper bound on the remeshing iterations, by default 10
+    convergence_tolerance : float, optional
+        Stop remeshing once an iteration changes the vertex, face and
+        out-of-band edge counts and the edge-length mean and spread each by
+        less than this fraction, by default 0.01 (1%). 0 always runs all
+        iterations.
+    token : CancelToken, optional
+        Reports progress and allows the call to be cancelled, raising
+        CancelledError, by default None
 
     Returns
     -------
@@ -178,24 +390,176 @@ def corefine_pyvista_polydata(
     """
     surface_1 = surface_1.triangulate()
     surface_2 = surface_2.triangulate()
-    tm1 = NumpyMesh()
-    tm1.vertices = np.array(surface_1.points).copy()
-    tm1.triangles = surface_1.faces.reshape(-1, 4)[:, 1:].copy()
-    tm2 = NumpyMesh()
-    tm2.vertices = np.array(surface_2.points).copy()
-    tm2.triangles = surface_2.faces.reshape(-1, 4)[:, 1:].copy()
-
-    tm1, tm2 = corefine_mesh(
-        tm1,
-        tm2,
-        target_edge_length=target_edge_length,
-        duplicate_vertex_threshold=duplicate_vertex_threshold,
-        area_threshold=area_threshold,
-        number_of_iterations=number_of_iterations,
-        relax_constraints=relax_constraints,
-        protect_constraints=protect_constraints,
-    )
-    return (
-        pv.PolyData.from_regular_faces(tm1.vertices, tm1.triangles),
-        pv.PolyData.from_regular_faces(tm2.vertices, tm2.triangles),
+    tm1 = _numpy_mesh(surface_1)
+    tm2 = _numpy_mesh(surface_2)
+
+    try:
+        tm1, tm2 = corefine_mesh(
+            tm1,
+            tm2,
+            target_edge_length=target_edge_length,
+            duplicate_vertex_threshold=duplicate_vertex_threshold,
+            area_threshold=area_threshold,
+            number_of_iterations=number_of_iterations,
+            relax_constraints=relax_constraints,
+            protect_constraints=protect_constraints,
+            convergence_tolerance=convergence_tolerance,
+            token=token,
+            **_VTK_EXPORT,
+        )
+    finally:
+        forward_log()
+    return _to_polydata(tm1), _to_polydata(tm2)
+
+
+def partition_pyvista_polydata(
+    surface: pv.PolyData,
+    clippers: List[pv.PolyData],
+    target_edge_length: float = 10.0,
+    remesh_before_partition: bool = True,
+    duplicate_vertex_threshold: float = 0.001,
+    area_threshold: float = 0.0001,
+    protect_constraints: bool = False,
+    relax_constraints: bool = True,
+    token: Optional[CancelToken] = None,
+) -> pv.PolyData:
+    """
+    Split a surface into fault blocks with a single corefinement pass.
+
+    Parameters
+    ----------
+    surface : pyvista.PolyData
+        The surface to be partitioned.
+    clippers : list of pyvista.PolyData
+        The cutting surfaces, e.g. faults.
+    target_edge_length : float, optional
+        The target edge length for the remeshing process, by default 10.0
+    remesh_before_partition : bool, optional
+        Whether to remesh the surface before cutting, by default True
+    duplicate_vertex_threshold : float, optional
+        The threshold for merging duplicate vertices, by default 0.001
+    area_threshold : float, optional
+        The area threshold for removing small faces, by default 0.0001
+    token : CancelToken, optional
+        Reports progress and allows the call to be cancelled, raising
+        CancelledError, by default None
+
+    Returns
+    -------
+    pyvista.PolyData
+        The welded surface with a ``block`` cell array labelling the
+        connected component bounded by the intersection curves.
+    """
+    surface = surface.triangulate()
+    tm = _numpy_mesh(surface)
+    cutting = [
+        _numpy_mesh(clipper.triangulate(), with_attributes=False)
+        for clipper in clippers
+    ]
+
+    try:
+        mesh, labels = partition_surface(
+            tm,
+            cutting,
+            target_edge_length=target_edge_length,
+            remesh_before_partition=remesh_before_partition,
+            duplicate_vertex_threshold=duplicate_vertex_threshold,
+            area_threshold=area_threshold,
+            protect_constraints=protect_constraints,
+            relax_constraints=relax_constraints,
+            token=token,
+            **_VTK_EXPORT,
+        )
+    finally:
+        forward_log()
+    polydata = _to_polydata(mesh)
+    polydata.cell_data["block"] = labels
+    return polydata
+
+
+def slice_pyvista_polydata(
+    surface: pv.PolyData,
+    plane_origins: np.ndarray,
+    plane_normals: np.ndarray,
+    token: Optional[CancelToken] = None,
+) -> pv.PolyData:
+    """
+    Cross-sections of a surface by many planes, computed in parallel.
+
+    Parameters
+    ----------
+    surface : pyvista.PolyData
+        The surface to be sliced.
+    plane_origins : np.ndarray
+        (n, 3) points on the planes.
+    plane_normals : np.ndarray
+        (n, 3) plane normals; a single normal is broadcast to every origin.
+    token : CancelToken, optional
+        Reports progress and allows the call to be cancelled, raising
+        CancelledError, by default None
+
+    Returns
+    -------
+    pyvista.PolyData
+        The section polylines, with a ``plane`` cell array giving the index
+        of the plane each line lies in.
+    """
+    surface = surface.triangulate()
+    origins = np.atleast_2d(np.asarray(plane_origins, dtype=np.float64))
+    normals = np.broadcast_to(
+        np.asarray(plane_normals, dtype=np.float64), origins.shape
     )
+    planes = []
+    for origin, normal in zip(origins, normals):
+        plane = NumpyPlane()
+        plane.origin = origin
+        plane.normal = normal
+        planes.append(plane)
+
+    try:
+        lines = slice_planes(
+            _numpy_mesh(surface, with_attributes=False), planes, token=token
+        )
+    finally:
+        forward_log()
+    return _polylines_to_polydata(lines, "plane")
+
+
+def intersection_pyvista_polydata(
+    surfaces: List[pv.PolyData],
+    pairs: Optional[List[Tuple[int, int]]] = None,
+    token: Optional[CancelToken] = None,
+) -> pv.PolyData:
+    """
+    Contact curves between surfaces, without clipping or remeshing.
+
+    Parameters
+    ----------
+    surfaces : list of pyvista.PolyData
+        The surfaces, e.g. horizons and faults.
+    pairs : list of (int, int), optional
+        Index pairs into surfaces to intersect, by default every pair.
+        The pairs are processed in parallel.
+    token : CancelToken, optional
+        Reports progress and allows the call to be cancelled, raising
+        CancelledError, by default None
+
+    Returns
+    -------
+    pyvista.PolyData
+        The intersection polylines, with a ``pair`` cell array giving the
+        index into pairs of the surfaces each line belongs to.
+    """
+    meshes = [
+        _numpy_mesh(surface.triangulate(), with_attributes=False)
+        for surface in surfaces
+    ]
+    if pairs is None:
+        pairs = [
+            (i, j) for i in range(len(meshes)) for j in range(i + 1, len(meshes))
+        ]
+    try:
+        lines = intersection_curves(meshes, pairs, token=token)
+    finally:
+        forward_log()
+    return _polylines_to_polydata(lines, "pair")
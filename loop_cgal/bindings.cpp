@@ -3,15 +3,242 @@
 
 #include "clip.h" // Include the API implementation
 #include "mesh.h"
+#include "meshutils.h"
 #include "numpymesh.h"
-#include "globals.h" // Include the global verbose flag
+#include "partition.h"
+#include "slice.h"
+#include "intersection.h"
+#include "remeshcache.h"
+#include "cancel.h"
+#include "memory.h"
+#include "globals.h" // Log levels and the log ring buffer
 namespace py = pybind11;
 
+namespace
+{
+     // Wraps array-likes without touching their dtype or layout; existing
+     // numpy arrays are passed through as they are and None is empty.
+     py::array as_array(const py::object &value, const char *what)
+     {
+          if (value.is_none())
+               return py::array();
+          py::array array = py::array::ensure(value);
+          if (!array)
+               throw py::type_error(std::string(what) +
+                                    " must be convertible to a numpy array.");
+          return array;
+     }
+
+     // Adds a trailing token argument that is current while f runs, so the
+     // checkpoints inside f see it without threading it through every call.
+     template <typename R, typename... Args>
+     auto cancellable(R (*f)(Args...))
+     {
+          return [f](Args... args, LoopCGAL::CancelToken *token) -> R
+          {
+               LoopCGAL::ScopedCancelToken scope(token);
+               return f(std::forward<Args>(args)...);
+          };
+     }
+
+     template <typename R, typename C, typename... Args>
+     auto cancellable(R (C::*f)(Args...))
+     {
+          return [f](C &self, Args... args, LoopCGAL::CancelToken *token) -> R
+          {
+               LoopCGAL::ScopedCancelToken scope(token);
+               return (self.*f)(std::forward<Args>(args)...);
+          };
+     }
+
+     // Optional index_type / face_layout arguments of the exporting calls;
+     // None keeps the module-wide default.
+     typedef std::optional<LoopCGAL::IndexType> IndexTypeArg;
+     typedef std::optional<LoopCGAL::FaceLayout> FaceLayoutArg;
+
+     LoopCGAL::ScopedExportFormat export_format(const IndexTypeArg &index_type,
+                                                const FaceLayoutArg &face_layout)
+     {
+          return LoopCGAL::ScopedExportFormat(
+              index_type ? static_cast<int>(*index_type) : -1,
+              face_layout ? static_cast<int>(*face_layout) : -1);
+     }
+
+     // cancellable, followed by the export format of this call
+     template <typename R, typename... Args>
+     auto exporting(R (*f)(Args...))
+     {
+          return [f](Args... args, LoopCGAL::CancelToken *token,
+                     const IndexTypeArg &index_type,
+                     const FaceLayoutArg &face_layout) -> R
+          {
+               LoopCGAL::ScopedCancelToken scope(token);
+               auto format = export_format(index_type, face_layout);
+               return f(std::forward<Args>(args)...);
+          };
+     }
+
+     template <typename R, typename C, typename... Args>
+     auto exporting(R (C::*f)(Args...))
+     {
+          return [f](C &self, Args... args, LoopCGAL::CancelToken *token,
+                     const IndexTypeArg &index_type,
+                     const FaceLayoutArg &face_layout) -> R
+          {
+               LoopCGAL::ScopedCancelToken scope(token);
+               auto format = export_format(index_type, face_layout);
+               return (self.*f)(std::forward<Args>(args)...);
+          };
+     }
+} // namespace
+
 PYBIND11_MODULE(_loop_cgal, m)
 {
-     m.attr("verbose") = &LoopCGAL::verbose; // Expose the global verbose flag
-     m.def("set_verbose", &LoopCGAL::set_verbose, "Set the verbose flag");
-     m.def("clip_surface", &clip_surface, py::arg("tm"), py::arg("clipper"),
+     py::enum_<LoopCGAL::LogLevel>(m, "LogLevel")
+         .value("OFF", LoopCGAL::LogLevel::Off)
+         .value("ERROR", LoopCGAL::LogLevel::Error)
+         .value("WARNING", LoopCGAL::LogLevel::Warning)
+         .value("INFO", LoopCGAL::LogLevel::Info)
+         .value("DEBUG", LoopCGAL::LogLevel::Debug);
+     m.def("set_verbose", &LoopCGAL::set_verbose,
+           "Log at DEBUG level when True, WARNING otherwise.");
+     m.def("set_log_level", &LoopCGAL::set_log_level, py::arg("level"),
+           "Set the module-wide log level.");
+     m.def("get_log_level", &LoopCGAL::get_log_level,
+           "Get the module-wide log level.");
+     m.def("set_stderr_level", &LoopCGAL::set_stderr_level, py::arg("level"),
+           "Also write records at or above this level to stderr; OFF "
+           "leaves the log buffer as the only sink. WARNING by default.");
+     m.def("get_stderr_level", &LoopCGAL::get_stderr_level,
+           "Get the level at which records are also written to stderr.");
+     py::enum_<LoopCGAL::ValidationLevel>(m, "ValidationLevel")
+         .value("OFF", LoopCGAL::ValidationLevel::Off)
+         .value("INPUTS_ONLY", LoopCGAL::ValidationLevel::InputsOnly)
+         .value("PARANOID", LoopCGAL::ValidationLevel::Paranoid);
+     m.def("set_validation_level", &LoopCGAL::set_validation_level,
+           py::arg("level"),
+           "Choose when full mesh validity checks run.");
+     m.def("get_validation_level", &LoopCGAL::get_validation_level,
+           "Get the module-wide validation level.");
+     py::enum_<LoopCGAL::IndexType>(m, "IndexType")
+         .value("INT32", LoopCGAL::IndexType::Int32)
+         .value("INT64", LoopCGAL::IndexType::Int64);
+     m.def("set_index_type", &LoopCGAL::set_index_type, py::arg("type"),
+           "Choose the default integer dtype of exported triangle arrays; "
+           "the exporting calls also take a per-call index_type.");
+     m.def("get_index_type", &LoopCGAL::get_index_type,
+           "Get the integer dtype of exported triangle arrays.");
+     py::enum_<LoopCGAL::FaceLayout>(m, "FaceLayout")
+         .value("ROWS", LoopCGAL::FaceLayout::Rows)
+         .value("PADDED", LoopCGAL::FaceLayout::Padded)
+         .value("OFFSETS", LoopCGAL::FaceLayout::Offsets);
+     m.def("set_face_layout", &LoopCGAL::set_face_layout, py::arg("layout"),
+           "Choose the default layout of exported triangle arrays; the "
+           "exporting calls also take a per-call face_layout. VTK only "
+           "adopts OFFSETS with INT64 indices without copying; the "
+           "default ROWS / INT32 export is copied into a PolyData.");
+     m.def("get_face_layout", &LoopCGAL::get_face_layout,
+           "Get the layout of exported triangle arrays.");
+     m.def("set_spatial_ordering", &LoopCGAL::set_spatial_ordering,
+           py::arg("value"),
+           "Hilbert-order loaded and exported meshes for memory locality.");
+     m.def("get_spatial_ordering", &LoopCGAL::get_spatial_ordering,
+           "Whether loaded and exported meshes are Hilbert-ordered.");
+     m.def("set_remesh_cache_budget", &LoopCGAL::set_remesh_cache_budget,
+           py::arg("bytes"),
+           "Memory budget of the pre-clip remesh cache; 0 disables it.");
+     m.def("clear_remesh_cache", &LoopCGAL::clear_remesh_cache,
+           "Drop all cached remeshed surfaces and reset the counters.");
+     m.def(
+         "remesh_cache_stats",
+         []()
+         {
+              const LoopCGAL::RemeshCacheStats stats =
+                  LoopCGAL::remesh_cache_stats();
+              py::dict result;
+              result["hits"] = stats.hits;
+              result["misses"] = stats.misses;
+              result["entries"] = stats.entries;
+              result["bytes"] = stats.bytes;
+              result["budget"] = stats.budget;
+              return result;
+         },
+         "Hit / miss counters and memory use of the remesh cache.");
+     m.def("set_num_threads", &LoopCGAL::set_num_threads, py::arg("n"),
+           "Worker threads for batched queries; 0 uses all cores.");
+     m.def("get_num_threads", &LoopCGAL::num_threads,
+           "Number of worker threads used by batched queries.");
+     m.def(
+         "memory_stats",
+         []()
+         {
+              py::dict result;
+              result["enabled"] = LoopCGAL::memory_accounting_enabled();
+              result["live"] = LoopCGAL::memory_live();
+              result["peak"] = LoopCGAL::memory_peak();
+              return result;
+         },
+         "Bytes of heap held by the module now and at peak since the last "
+         "reset_memory_peak(). Only counted when the module is built with "
+         "-DLOOPCGAL_MEMORY_ACCOUNTING=ON; 'enabled' tells.");
+     m.def("reset_memory_peak", &LoopCGAL::reset_memory_peak,
+           "Restart the peak counter from the bytes held now.");
+     m.def(
+         "drain_memory_reports",
+         []()
+         {
+              py::list reports;
+              for (const auto &report : LoopCGAL::drain_memory_reports())
+              {
+                   py::list phases;
+                   for (const auto &phase : report.phases)
+                   {
+                        py::dict entry;
+                        entry["name"] = phase.name;
+                        entry["start"] = phase.start;
+                        entry["peak"] = phase.peak;
+                        entry["end"] = phase.end;
+                        phases.append(entry);
+                   }
+                   py::dict entry;
+                   entry["call"] = report.call;
+                   entry["start"] = report.start;
+                   entry["peak"] = report.peak;
+                   entry["end"] = report.end;
+                   entry["phases"] = phases;
+                   reports.append(entry);
+              }
+              return reports;
+         },
+         "Remove and return the per-phase memory reports (bytes live at "
+         "start, peak and end) of the most recent calls.");
+     m.def(
+         "drain_log",
+         []()
+         {
+              py::list records;
+              for (const auto &record : LoopCGAL::drain_log())
+                   records.append(py::make_tuple(record.level,
+                                                 py::str(record.message)));
+              return records;
+         },
+         "Remove and return all buffered (level, message) log records.");
+     m.def("dropped_log_records", &LoopCGAL::dropped_log_records,
+           "Number of log records dropped because the buffer was full.");
+     py::register_exception<LoopCGAL::CancelledError>(m, "CancelledError");
+     py::class_<LoopCGAL::CancelToken>(
+         m, "CancelToken",
+         "Cancels a running call from another thread, or from its progress "
+         "callback(stage, fraction) by returning False.")
+         .def(py::init<>())
+         .def(py::init<py::object>(), py::arg("callback"))
+         .def("cancel", &LoopCGAL::CancelToken::cancel,
+              "Stop the call at its next checkpoint.")
+         .def("reset", &LoopCGAL::CancelToken::reset,
+              "Clear the cancelled flag so the token can be reused.")
+         .def_property_readonly("cancelled",
+                                &LoopCGAL::CancelToken::cancelled);
+     m.def("clip_surface", exporting(&clip_surface), py::arg("tm"), py::arg("clipper"),
            py::arg("target_edge_length") = 10.0,
            py::arg("remesh_before_clipping") = true,
            py::arg("remesh_after_clipping") = true,
@@ -20,8 +247,14 @@ PYBIND11_MODULE(_loop_cgal, m)
            py::arg("area_threshold") = 1e-6,
            py::arg("protect_constraints") = false,
            py::arg("relax_constraints") = true, py::arg("verbose") = false,
-           "Clip one surface with another.");
-     m.def("clip_plane", &clip_plane, py::arg("tm"), py::arg("clipper"),
+           py::arg("convergence_tolerance") = 0.01,
+           py::arg("region_of_interest") = false,
+           py::arg("token") = py::none(),
+           py::arg("index_type") = py::none(),
+           py::arg("face_layout") = py::none(),
+           "Clip one surface with another. With region_of_interest only "
+           "the faces near the clipper are remeshed and clipped.");
+     m.def("clip_plane", exporting(&clip_plane), py::arg("tm"), py::arg("clipper"),
            py::arg("target_edge_length") = 10.0,
            py::arg("remesh_before_clipping") = true,
            py::arg("remesh_after_clipping") = true,
@@ -30,39 +263,218 @@ PYBIND11_MODULE(_loop_cgal, m)
            py::arg("area_threshold") = 1e-6,
            py::arg("protect_constraints") = false,
            py::arg("relax_constraints") = true, py::arg("verbose") = false,
+           py::arg("convergence_tolerance") = 0.01,
+           py::arg("token") = py::none(),
+           py::arg("index_type") = py::none(),
+           py::arg("face_layout") = py::none(),
            "Clip a surface with a plane.");
-     m.def("corefine_mesh", &corefine_mesh, py::arg("tm1"), py::arg("tm2"),
+     m.def("corefine_mesh", exporting(&corefine_mesh), py::arg("tm1"), py::arg("tm2"),
            py::arg("target_edge_length") = 10.0,
            py::arg("duplicate_vertex_threshold") = 1e-6,
            py::arg("area_threshold") = 1e-6, py::arg("number_of_iterations") = 3,
            py::arg("relax_constraints") = true,
            py::arg("protect_constraints") = false, py::arg("verbose") = false,
+           py::arg("convergence_tolerance") = 0.01,
+           py::arg("token") = py::none(),
+           py::arg("index_type") = py::none(),
+           py::arg("face_layout") = py::none(),
            "Corefine two meshes.");
+     m.def("partition_surface", exporting(&partition_surface), py::arg("tm"),
+           py::arg("clippers"), py::arg("target_edge_length") = 10.0,
+           py::arg("remesh_before_partition") = true,
+           py::arg("duplicate_vertex_threshold") = 1e-6,
+           py::arg("area_threshold") = 1e-6,
+           py::arg("protect_constraints") = false,
+           py::arg("relax_constraints") = true, py::arg("verbose") = false,
+           py::arg("token") = py::none(),
+           py::arg("index_type") = py::none(),
+           py::arg("face_layout") = py::none(),
+           "Split a surface by many clippers in one pass. Returns the mesh "
+           "and a block label per triangle.");
+     m.def("slice_planes", cancellable(&slice_planes), py::arg("tm"), py::arg("planes"),
+           py::arg("verbose") = false, py::arg("token") = py::none(),
+           "Intersect a surface with many planes in parallel. Returns the "
+           "cross-sections as packed polylines.");
+     m.def("intersection_curves", cancellable(&intersection_curves), py::arg("tm1"),
+           py::arg("tm2"), py::arg("verbose") = false,
+           py::arg("token") = py::none(),
+           "Intersection polylines of two surfaces, without clipping.");
+     m.def("intersection_curves", cancellable(&intersection_curves_batch),
+           py::arg("meshes"), py::arg("pairs"), py::arg("verbose") = false,
+           py::arg("token") = py::none(),
+           "Intersection polylines of many (i, j) mesh pairs, in parallel.");
+     py::class_<NumpyPolylines>(m, "NumpyPolylines")
+         .def(py::init<>())
+         .def_readwrite("vertices", &NumpyPolylines::vertices)
+         .def_readwrite("offsets", &NumpyPolylines::offsets,
+                        "Start row of each polyline, plus the total.")
+         .def_readwrite("ids", &NumpyPolylines::ids,
+                        "Index of the plane or pair of each polyline.");
      py::class_<NumpyMesh>(m, "NumpyMesh")
          .def(py::init<>())
-         .def_readwrite("vertices", &NumpyMesh::vertices)
-         .def_readwrite("triangles", &NumpyMesh::triangles); 
+         .def_property(
+             "vertices", [](const NumpyMesh &self) { return self.vertices; },
+             [](NumpyMesh &self, const py::object &value)
+             {
+                  detach_exported(self);
+                  self.vertices = as_array(value, "vertices");
+             },
+             "(n, 3) float32 or float64 array, read in place. On results "
+             "of the clip functions a read-only view of the result mesh.")
+         .def_property(
+             "triangles",
+             [](const NumpyMesh &self) { return mesh_triangles(self); },
+             [](NumpyMesh &self, const py::object &value)
+             {
+                  detach_exported(self);
+                  self.triangles = as_array(value, "triangles");
+             },
+             "(n, 3) rows, padded VTK cells or VTK connectivity; any "
+             "integer width, read in place. On results of the clip "
+             "functions built on first access, in the call's index_type "
+             "and face_layout; only OFFSETS / INT64 can back a VTK cell "
+             "array without a copy.")
+         .def_property(
+             "offsets", [](const NumpyMesh &self) { return mesh_offsets(self); },
+             [](NumpyMesh &self, const py::object &value)
+             {
+                  detach_exported(self);
+                  self.offsets = as_array(value, "offsets");
+             },
+             "VTK cell offsets when triangles holds connectivity, else "
+             "empty.")
+         .def_property_readonly(
+             "n_vertices",
+             [](const NumpyMesh &self)
+             {
+                  return self.vertices.ndim() == 2 ? self.vertices.shape(0)
+                                                   : ssize_t(0);
+             })
+         .def_property_readonly(
+             "n_triangles", &mesh_triangle_count,
+             "Number of triangles, without building the triangle array.")
+         .def_property_readonly(
+             "bounds",
+             [](const NumpyMesh &self)
+             {
+                  const CGAL::Bbox_3 box = mesh_bbox(self);
+                  return py::make_tuple(box.xmin(), box.xmax(), box.ymin(),
+                                        box.ymax(), box.zmin(), box.zmax());
+             },
+             "(xmin, xmax, ymin, ymax, zmin, zmax), as in pyvista.")
+         .def_readwrite("vertex_attributes", &NumpyMesh::vertex_attributes,
+                        "Named per-vertex scalar fields.")
+         .def_readwrite("face_attributes", &NumpyMesh::face_attributes,
+                        "Named per-triangle scalar fields.");
      py::class_<NumpyPlane>(m, "NumpyPlane")
          .def(py::init<>())
          .def_readwrite("normal", &NumpyPlane::normal)
          .def_readwrite("origin", &NumpyPlane::origin);
-     py::class_<TriMesh>(m, "TriMesh")
-         .def(py::init<const pybind11::array_t<double> &, const pybind11::array_t<int> &>(),
-              py::arg("vertices"), py::arg("triangles"))
-         .def("cut_with_surface", &TriMesh::cutWithSurface, py::arg("surface"),
-              py::arg("preserve_intersection") = false,
-              py::arg("preserve_intersection_clipper") = false)
-         .def("remesh", &TriMesh::remesh, py::arg("split_long_edges") = true,
+     py::class_<TriMesh>(m, "TriMesh",
+                         "A mesh kept in C++ between calls. Its methods run "
+                         "with the GIL released and take an optional cancel "
+                         "token. Safe to share between threads: calls on one "
+                         "mesh run one at a time.")
+         .def(py::init(
+                  [](const py::object &vertices, const py::object &triangles,
+                     const py::object &offsets, LoopCGAL::CancelToken *token)
+                  {
+                       LoopCGAL::ScopedCancelToken scope(token);
+                       return std::make_unique<TriMesh>(
+                           as_array(vertices, "vertices"),
+                           as_array(triangles, "triangles"),
+                           as_array(offsets, "offsets"));
+                  }),
+              py::arg("vertices"), py::arg("triangles"),
+              py::arg("offsets") = py::none(), py::arg("token") = py::none())
+         .def(py::init(
+                  [](const NumpyMesh &mesh, LoopCGAL::CancelToken *token)
+                  {
+                       LoopCGAL::ScopedCancelToken scope(token);
+                       return std::make_unique<TriMesh>(mesh);
+                  }),
+              py::arg("mesh"), py::arg("token") = py::none(),
+              "Load a NumpyMesh; results of the clip functions and save() "
+              "are copied without going through their arrays.")
+         .def("cut_with_surface", cancellable(&TriMesh::cutWithSurface),
+              py::arg("surface"), py::arg("preserve_intersection") = false,
+              py::arg("preserve_intersection_clipper") = false,
+              py::arg("token") = py::none())
+         .def("clip_plane", cancellable(&TriMesh::clipPlane), py::arg("normal"),
+              py::arg("origin"), py::arg("token") = py::none(),
+              "Clip the mesh in place, keeping the side opposite the normal.")
+         .def("corefine", cancellable(&TriMesh::corefine), py::arg("other"),
+              py::arg("token") = py::none(),
+              "Corefine both meshes in place and fix the intersection edges.")
+         .def("remove_degenerate_faces",
+              cancellable(&TriMesh::removeDegenerateFaces),
+              py::arg("token") = py::none(),
+              "Remove (almost) degenerate faces in place.")
+         .def("stitch", cancellable(&TriMesh::stitch),
+              py::arg("token") = py::none(),
+              "Stitch borders and merge duplicated boundary vertices.")
+         .def("remesh", cancellable(&TriMesh::remesh),
+              py::arg("split_long_edges") = true,
               py::arg("target_edge_length") = 10.0,
               py::arg("number_of_iterations") = 3,
               py::arg("protect_constraints") = true,
-              py::arg("relax_constraints") = false)
-         .def("save", &TriMesh::save, py::arg("area_threshold") = 1e-6,
-              py::arg("duplicate_vertex_threshold") = 1e-6)
+              py::arg("relax_constraints") = false,
+              py::arg("convergence_tolerance") = 0.01,
+              py::arg("token") = py::none(),
+              "Remesh in place and return the number of iterations run.")
+         .def("save", exporting(&TriMesh::save),
+              py::arg("area_threshold") = 1e-6,
+              py::arg("duplicate_vertex_threshold") = 1e-6,
+              py::arg("token") = py::none(),
+              py::arg("index_type") = py::none(),
+              py::arg("face_layout") = py::none())
          .def("reverse_face_orientation", &TriMesh::reverseFaceOrientation,
               "Reverse the face orientation of the mesh.")
          .def("add_fixed_edges", &TriMesh::add_fixed_edges,
               py::arg("pairs"),
-              "Vertex index pairs defining edges to be fixed in mesh when remeshing.");
+              "Vertex index pairs defining edges to be fixed in mesh when remeshing.")
+         .def_property_readonly("n_fixed_edges", &TriMesh::fixedEdgeCount,
+                                "Number of edges fixed when remeshing.")
+         .def_property("fix_new_borders", &TriMesh::fixNewBorders,
+                       &TriMesh::setFixNewBorders,
+                       "Also fix the borders created by clip_plane, "
+                       "cut_with_surface, corefine, stitch and "
+                       "remove_degenerate_faces. Off by default.")
+         .def(
+             "signed_distance",
+             [](TriMesh &self, const py::object &points,
+                LoopCGAL::CancelToken *token)
+             {
+                  LoopCGAL::ScopedCancelToken scope(token);
+                  return self.signedDistance(as_array(points, "points"));
+             },
+             py::arg("points"), py::arg("token") = py::none(),
+             "Signed distance of each (n, 3) point to the mesh, positive on "
+             "the side the faces point to. Runs in parallel with the GIL "
+             "released; edits of the mesh from other threads wait for it.")
+         .def(
+             "closest_point",
+             [](TriMesh &self, const py::object &points,
+                LoopCGAL::CancelToken *token)
+             {
+                  LoopCGAL::ScopedCancelToken scope(token);
+                  return self.closestPoint(as_array(points, "points"));
+             },
+             py::arg("points"), py::arg("token") = py::none(),
+             "Closest point on the mesh for each (n, 3) point. Runs in "
+             "parallel with the GIL released; edits of the mesh from other "
+             "threads wait for it.")
+         .def(py::pickle(
+             [](const TriMesh &self) { return py::bytes(self.serialize()); },
+             [](const py::bytes &state)
+             {
+                  char *buffer = nullptr;
+                  Py_ssize_t length = 0;
+                  if (PYBIND11_BYTES_AS_STRING_AND_SIZE(state.ptr(), &buffer,
+                                                        &length) != 0)
+                       throw py::error_already_set();
+                  return TriMesh::deserialize(
+                      buffer, static_cast<std::size_t>(length));
+             }));
 
 } // End of PYBIND11_MODULE
\ No newline at end of file
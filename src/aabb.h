@@ -0,0 +1,63 @@
+#ifndef AABB_H
+#define AABB_H
+// AABB tree typedefs shared by the query and transfer code. CGAL 6 renamed
+// the traits and primitives with a _3 suffix.
+#include <CGAL/AABB_face_graph_triangle_primitive.h>
+#include <CGAL/AABB_halfedge_graph_segment_primitive.h>
+#include <CGAL/AABB_tree.h>
+#include <CGAL/Simple_cartesian.h>
+#include <CGAL/Surface_mesh.h>
+#include <CGAL/version.h>
+#if CGAL_VERSION_NR >= 1060000000
+#include <CGAL/AABB_segment_primitive_3.h>
+#include <CGAL/AABB_traits_3.h>
+#include <CGAL/AABB_triangle_primitive_3.h>
+#else
+#include <CGAL/AABB_segment_primitive.h>
+#include <CGAL/AABB_traits.h>
+#include <CGAL/AABB_triangle_primitive.h>
+#endif
+#include <vector>
+
+typedef CGAL::Simple_cartesian<double> Kernel;
+typedef Kernel::Point_3 Point;
+typedef Kernel::Triangle_3 Triangle;
+typedef Kernel::Segment_3 Segment;
+typedef CGAL::Surface_mesh<Point> TriangleMesh;
+
+typedef std::vector<Triangle>::const_iterator TriangleIterator;
+typedef std::vector<Segment>::const_iterator SegmentIterator;
+#if CGAL_VERSION_NR >= 1060000000
+typedef CGAL::AABB_segment_primitive_3<Kernel, SegmentIterator>
+    SegmentPrimitive;
+typedef CGAL::AABB_traits_3<Kernel, SegmentPrimitive> SegmentTraits;
+typedef CGAL::AABB_triangle_primitive_3<Kernel, TriangleIterator>
+    SoupPrimitive;
+typedef CGAL::AABB_traits_3<Kernel, SoupPrimitive> SoupTraits;
+typedef CGAL::AABB_face_graph_triangle_primitive<TriangleMesh> FacePrimitive;
+typedef CGAL::AABB_traits_3<Kernel, FacePrimitive> FaceTraits;
+typedef CGAL::AABB_halfedge_graph_segment_primitive<TriangleMesh>
+    EdgePrimitive;
+typedef CGAL::AABB_traits_3<Kernel, EdgePrimitive> EdgeTraits;
+#else
+typedef CGAL::AABB_segment_primitive<Kernel, SegmentIterator>
+    SegmentPrimitive;
+typedef CGAL::AABB_traits<Kernel, SegmentPrimitive> SegmentTraits;
+typedef CGAL::AABB_triangle_primitive<Kernel, TriangleIterator> SoupPrimitive;
+typedef CGAL::AABB_traits<Kernel, SoupPrimitive> SoupTraits;
+typedef CGAL::AABB_face_graph_triangle_primitive<TriangleMesh> FacePrimitive;
+typedef CGAL::AABB_traits<Kernel, FacePrimitive> FaceTraits;
+typedef CGAL::AABB_halfedge_graph_segment_primitive<TriangleMesh>
+    EdgePrimitive;
+typedef CGAL::AABB_traits<Kernel, EdgePrimitive> EdgeTraits;
+#endif
+// Tree over a triangle soup; primitive ids are iterators into the soup.
+typedef CGAL::AABB_tree<SoupTraits> SoupTree;
+// Tree over a segment soup; primitive ids are iterators into the soup.
+typedef CGAL::AABB_tree<SegmentTraits> SegmentTree;
+// Tree over the faces of a TriangleMesh; primitive ids are face indices.
+typedef CGAL::AABB_tree<FaceTraits> FaceTree;
+// Tree over the edges of a TriangleMesh, as used by Polygon_mesh_slicer.
+typedef CGAL::AABB_tree<EdgeTraits> EdgeTree;
+
+#endif // AABB_H
@@ -0,0 +1,172 @@
+#ifndef ARRAYVIEW_H
+#define ARRAYVIEW_H
+
+#include <pybind11/numpy.h>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+// In-place access to the vertex and triangle arrays handed over from numpy.
+// The visitor is instantiated once per supported dtype and reads through
+// the array's own strides, so float32 points, int64 faces and column
+// slices such as faces.reshape(-1, 4)[:, 1:] are used where they live.
+// Other dtypes fall back to a single converted copy.
+//
+// Triangles are accepted in three layouts:
+//   rows     (n, 3) array
+//   padded   1D legacy VTK cell array [3, i, j, k, 3, ...]
+//   offsets  1D VTK connectivity plus offsets (n + 1) [0, 3, 6, ...]
+namespace LoopCGAL
+{
+    template <typename T>
+    bool has_dtype(const pybind11::array &array)
+    {
+        return pybind11::isinstance<pybind11::array_t<T>>(array);
+    }
+
+    inline void check_rows(const pybind11::array &array, const char *what)
+    {
+        if (array.ndim() != 2 || array.shape(1) != 3)
+            throw std::invalid_argument(std::string(what) +
+                                        " must be an (n, 3) array.");
+    }
+
+    template <typename T>
+    pybind11::array_t<T> converted(const pybind11::array &array,
+                                   const char *what)
+    {
+        auto result =
+            pybind11::array_t<T, pybind11::array::forcecast>::ensure(array);
+        if (!result)
+            throw std::invalid_argument(std::string(what) +
+                                        " has an unsupported dtype.");
+        return result;
+    }
+
+    // f(view) with view(i, k) returning float or double
+    template <typename F>
+    void visit_coordinates(const pybind11::array &array, F &&f)
+    {
+        check_rows(array, "vertices");
+        if (has_dtype<double>(array))
+            f(array.unchecked<double, 2>());
+        else if (has_dtype<float>(array))
+            f(array.unchecked<float, 2>());
+        else
+        {
+            auto copy = converted<double>(array, "vertices");
+            f(copy.unchecked<2>());
+        }
+    }
+
+    // f(view) with view(...) returning a signed or unsigned integer
+    template <ssize_t Dims, typename F>
+    void visit_integers(const pybind11::array &array, const char *what, F &&f)
+    {
+        if (has_dtype<std::int32_t>(array))
+            f(array.unchecked<std::int32_t, Dims>());
+        else if (has_dtype<std::int64_t>(array))
+            f(array.unchecked<std::int64_t, Dims>());
+        else if (has_dtype<std::uint32_t>(array))
+            f(array.unchecked<std::uint32_t, Dims>());
+        else if (has_dtype<std::uint64_t>(array))
+            f(array.unchecked<std::uint64_t, Dims>());
+        else
+        {
+            auto copy = converted<std::int64_t>(array, what);
+            f(copy.template unchecked<Dims>());
+        }
+    }
+
+    // Corner k of triangle i, for each of the layouts above
+    template <typename View>
+    struct RowTriangles
+    {
+        View view;
+        ssize_t size() const { return view.shape(0); }
+        auto operator()(ssize_t i, int k) const { return view(i, k); }
+    };
+
+    template <typename View>
+    struct PackedTriangles
+    {
+        View view;
+        ssize_t stride; // 4 when each cell starts with its point count
+        ssize_t count;
+        ssize_t size() const { return count; }
+        auto operator()(ssize_t i, int k) const
+        {
+            return view(i * stride + (stride - 3) + k);
+        }
+    };
+
+    inline ssize_t triangle_count(const pybind11::array &triangles,
+                                  const pybind11::array &offsets)
+    {
+        if (offsets.size() > 0)
+            return offsets.shape(0) - 1;
+        if (triangles.ndim() == 1)
+            return triangles.shape(0) / 4;
+        return triangles.ndim() == 2 ? triangles.shape(0) : 0;
+    }
+
+    // f(triangles) with triangles.size() and triangles(i, k). Cells that
+    // are not triangles are rejected rather than silently re-split.
+    template <typename F>
+    void visit_triangles(const pybind11::array &triangles,
+                         const pybind11::array &offsets, F &&f)
+    {
+        const char *not_triangles =
+            "Only triangle cells are supported; triangulate the mesh first.";
+        if (offsets.size() > 0)
+        {
+            if (offsets.ndim() != 1 || triangles.ndim() != 1)
+                throw std::invalid_argument(
+                    "offsets and connectivity must be 1D arrays.");
+            const ssize_t count = offsets.shape(0) - 1;
+            visit_integers<1>(offsets, "offsets", [&](auto offset) {
+                for (ssize_t i = 0; i <= count; ++i)
+                    if (static_cast<std::int64_t>(offset(i)) != 3 * i)
+                        throw std::invalid_argument(not_triangles);
+            });
+            if (triangles.shape(0) != 3 * count)
+                throw std::invalid_argument(
+                    "connectivity does not match offsets.");
+            visit_integers<1>(triangles, "connectivity", [&](auto cells) {
+                f(PackedTriangles<decltype(cells)>{cells, 3, count});
+            });
+        }
+        else if (triangles.ndim() == 1)
+        {
+            if (triangles.shape(0) % 4 != 0)
+                throw std::invalid_argument(not_triangles);
+            const ssize_t count = triangles.shape(0) / 4;
+            visit_integers<1>(triangles, "triangles", [&](auto cells) {
+                for (ssize_t i = 0; i < count; ++i)
+                    if (cells(4 * i) != 3)
+                        throw std::invalid_argument(not_triangles);
+                f(PackedTriangles<decltype(cells)>{cells, 4, count});
+            });
+        }
+        else
+        {
+            check_rows(triangles, "triangles");
+            visit_integers<2>(triangles, "triangles", [&](auto rows) {
+                f(RowTriangles<decltype(rows)>{rows});
+            });
+        }
+    }
+
+    // Bounds check that works for both signed and unsigned index types
+    template <typename Index>
+    bool index_in_range(Index index, std::size_t size)
+    {
+        if constexpr (std::is_signed<Index>::value)
+            if (index < 0)
+                return false;
+        return static_cast<std::size_t>(index) < size;
+    }
+}
+
+#endif // ARRAYVIEW_H
@@ -0,0 +1,212 @@
+#include "attributes.h"
+#include "arrayview.h"
+#include "globals.h"
+#include "meshutils.h"
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <stdexcept>
+
+namespace
+{
+  std::vector<double> read_attribute(const pybind11::array_t<double> &array,
+                                     ssize_t expected, const std::string &name)
+  {
+    if (array.ndim() != 1 || array.shape(0) != expected)
+      throw std::invalid_argument("Attribute '" + name +
+                                  "' must be a 1D array of length " +
+                                  std::to_string(expected) + ".");
+    auto buf = array.unchecked<1>();
+    std::vector<double> values(expected);
+    for (ssize_t i = 0; i < expected; ++i)
+      values[i] = buf(i);
+    return values;
+  }
+} // namespace
+
+AttributeTransfer::AttributeTransfer(const NumpyMesh &mesh)
+{
+  if (mesh.vertex_attributes.empty() && mesh.face_attributes.empty())
+    return;
+
+  LoopCGAL::check_rows(mesh.vertices, "vertices");
+  const ssize_t n_vertices = mesh.vertices.shape(0);
+  const pybind11::array &triangles = mesh_triangles(mesh);
+  const pybind11::array &offsets = mesh_offsets(mesh);
+  const ssize_t n_triangles = LoopCGAL::triangle_count(triangles, offsets);
+
+  for (const auto &entry : mesh.vertex_attributes)
+  {
+    _vertex_names.push_back(entry.first);
+    _vertex_values.push_back(
+        read_attribute(entry.second, n_vertices, entry.first));
+  }
+  for (const auto &entry : mesh.face_attributes)
+  {
+    _face_names.push_back(entry.first);
+    _face_values.push_back(
+        read_attribute(entry.second, n_triangles, entry.first));
+  }
+
+  _triangles.reserve(n_triangles);
+  _triangle_rows.reserve(n_triangles);
+  _face_rows.reserve(n_triangles);
+  VertexSets sets(static_cast<std::size_t>(n_vertices));
+  LoopCGAL::visit_coordinates(mesh.vertices, [&](auto vertices_buf) {
+    // Rows at the same position belong to the same component even when the
+    // input is an unwelded soup
+    std::map<std::array<double, 3>, std::size_t> first_row;
+    for (ssize_t i = 0; i < n_vertices; ++i)
+    {
+      const std::array<double, 3> key = {
+          vertices_buf(i, 0), vertices_buf(i, 1), vertices_buf(i, 2)};
+      sets.unite(i, first_row.emplace(key, static_cast<std::size_t>(i))
+                        .first->second);
+    }
+    LoopCGAL::visit_triangles(triangles, offsets,
+                              [&](auto triangles_buf) {
+      for (ssize_t i = 0; i < triangles_buf.size(); ++i)
+      {
+        std::array<int, 3> rows;
+        std::array<Point, 3> corners;
+        for (int k = 0; k < 3; ++k)
+        {
+          if (!LoopCGAL::index_in_range(triangles_buf(i, k),
+                                        static_cast<std::size_t>(n_vertices)))
+            throw std::invalid_argument("Triangle index out of range.");
+          rows[k] = static_cast<int>(triangles_buf(i, k));
+          corners[k] = Point(vertices_buf(rows[k], 0),
+                             vertices_buf(rows[k], 1),
+                             vertices_buf(rows[k], 2));
+        }
+        Triangle triangle(corners[0], corners[1], corners[2]);
+        if (triangle.is_degenerate())
+          continue; // cannot be located reliably; neighbours cover its area
+        _triangles.push_back(triangle);
+        _triangle_rows.push_back(rows);
+        _face_rows.push_back(static_cast<std::size_t>(i));
+        sets.unite(rows[0], rows[1]);
+        sets.unite(rows[0], rows[2]);
+      }
+    });
+  });
+  if (_triangles.empty())
+    return;
+
+  // Number the components and group the soup entries by component
+  std::map<std::size_t, std::size_t> component_of_root;
+  std::vector<std::size_t> component(_triangles.size());
+  for (std::size_t i = 0; i < _triangles.size(); ++i)
+    component[i] = component_of_root
+                       .emplace(sets.find(_triangle_rows[i][0]),
+                                component_of_root.size())
+                       .first->second;
+  const std::size_t n_components = component_of_root.size();
+  std::vector<std::size_t> order(_triangles.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&](std::size_t a, std::size_t b)
+                   { return component[a] < component[b]; });
+  std::vector<Triangle> sorted_triangles;
+  std::vector<std::array<int, 3>> sorted_rows;
+  std::vector<std::size_t> sorted_faces;
+  sorted_triangles.reserve(order.size());
+  sorted_rows.reserve(order.size());
+  sorted_faces.reserve(order.size());
+  _component_begin.assign(n_components + 1, 0);
+  for (std::size_t i : order)
+  {
+    sorted_triangles.push_back(_triangles[i]);
+    sorted_rows.push_back(_triangle_rows[i]);
+    sorted_faces.push_back(_face_rows[i]);
+    ++_component_begin[component[i] + 1];
+  }
+  std::partial_sum(_component_begin.begin(), _component_begin.end(),
+                   _component_begin.begin());
+  _triangles.swap(sorted_triangles);
+  _triangle_rows.swap(sorted_rows);
+  _face_rows.swap(sorted_faces);
+
+  _tree.reset(new SoupTree(_triangles.begin(), _triangles.end()));
+  _tree->accelerate_distance_queries();
+  if (n_components > 1)
+    for (std::size_t c = 0; c < n_components; ++c)
+    {
+      _component_trees.emplace_back(
+          new SoupTree(_triangles.begin() + _component_begin[c],
+                       _triangles.begin() + _component_begin[c + 1]));
+      _component_trees.back()->accelerate_distance_queries();
+    }
+  LOOPCGAL_DEBUG("Tracking " << _vertex_names.size() << " vertex and "
+                             << _face_names.size() << " face attributes on "
+                             << n_components << " components.");
+}
+
+std::size_t AttributeTransfer::locate(const Point &p, std::size_t component,
+                                      Point &closest) const
+{
+  const SoupTree &tree = component < _component_trees.size()
+                             ? *_component_trees[component]
+                             : *_tree;
+  auto hit = tree.closest_point_and_primitive(p);
+  closest = hit.first;
+  return static_cast<std::size_t>(hit.second - _triangles.begin());
+}
+
+std::size_t AttributeTransfer::component_at(const Point &p) const
+{
+  if (!_tree)
+    return any_component;
+  Point q;
+  const std::size_t i = locate(p, any_component, q);
+  return static_cast<std::size_t>(
+      std::upper_bound(_component_begin.begin(), _component_begin.end(), i) -
+      _component_begin.begin() - 1);
+}
+
+void AttributeTransfer::sample_vertex(const Point &p, std::size_t component,
+                                      double *out) const
+{
+  if (!_tree)
+  {
+    std::fill(out, out + _vertex_names.size(),
+              std::numeric_limits<double>::quiet_NaN());
+    return;
+  }
+  Point q;
+  const std::size_t i = locate(p, component, q);
+  const Triangle &t = _triangles[i];
+
+  // Barycentric coordinates of the closest point, clamped against round-off
+  const Kernel::Vector_3 v0 = t[1] - t[0], v1 = t[2] - t[0], v2 = q - t[0];
+  const double d00 = v0 * v0, d01 = v0 * v1, d11 = v1 * v1;
+  const double d20 = v2 * v0, d21 = v2 * v1;
+  const double denom = d00 * d11 - d01 * d01;
+  double w1 = (d11 * d20 - d01 * d21) / denom;
+  double w2 = (d00 * d21 - d01 * d20) / denom;
+  w1 = std::min(std::max(w1, 0.0), 1.0);
+  w2 = std::min(std::max(w2, 0.0), 1.0 - w1);
+  const double w0 = 1.0 - w1 - w2;
+
+  const std::array<int, 3> &rows = _triangle_rows[i];
+  for (std::size_t a = 0; a < _vertex_values.size(); ++a)
+  {
+    const std::vector<double> &values = _vertex_values[a];
+    out[a] = w0 * values[rows[0]] + w1 * values[rows[1]] + w2 * values[rows[2]];
+  }
+}
+
+void AttributeTransfer::sample_face(const Point &centroid,
+                                    std::size_t component, double *out) const
+{
+  if (!_tree)
+  {
+    std::fill(out, out + _face_names.size(),
+              std::numeric_limits<double>::quiet_NaN());
+    return;
+  }
+  Point q;
+  const std::size_t row = _face_rows[locate(centroid, component, q)];
+  for (std::size_t a = 0; a < _face_values.size(); ++a)
+    out[a] = _face_values[a][row];
+}
@@ -0,0 +1,107 @@
+#ifndef ATTRIBUTES_H
+#define ATTRIBUTES_H
+#include "aabb.h"
+#include "numpymesh.h"
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+// Union-find over vertex indices, used to split meshes into connected
+// components
+class VertexSets
+{
+public:
+  explicit VertexSets(std::size_t n) : _parent(n)
+  {
+    std::iota(_parent.begin(), _parent.end(), std::size_t(0));
+  }
+  std::size_t find(std::size_t i)
+  {
+    while (_parent[i] != i)
+      i = _parent[i] = _parent[_parent[i]];
+    return i;
+  }
+  void unite(std::size_t a, std::size_t b)
+  {
+    a = find(a);
+    b = find(b);
+    if (a != b)
+      _parent[std::max(a, b)] = std::min(a, b);
+  }
+
+private:
+  std::vector<std::size_t> _parent;
+};
+
+// Per-vertex and per-face scalar fields of an input mesh. The input
+// triangles are kept as a soup with an AABB tree so that any output vertex
+// (original, split, clipped or remeshed) can be given the barycentric
+// interpolation of the nearest input triangle, and any output face the
+// value of the input face nearest to its centroid.
+//
+// The soup is split into the connected components of the input (triangles
+// sharing a vertex row or a vertex position), each with its own tree. The
+// exporter maps each connected component of the output to the input
+// component most of its vertices lie on and only searches that one, so two
+// close sheets keep their own values however far remeshing moves a vertex.
+// Within one component this is still a closest-point lookup: where a single
+// sheet folds back closer than the remeshing moves a vertex, the value may
+// come from the other side of the fold.
+class AttributeTransfer
+{
+public:
+  // Searches every input component
+  static constexpr std::size_t any_component = static_cast<std::size_t>(-1);
+
+  explicit AttributeTransfer(const NumpyMesh &mesh);
+  AttributeTransfer(const AttributeTransfer &) = delete;
+  AttributeTransfer &operator=(const AttributeTransfer &) = delete;
+
+  bool empty() const
+  {
+    return _vertex_names.empty() && _face_names.empty();
+  }
+  const std::vector<std::string> &vertex_names() const
+  {
+    return _vertex_names;
+  }
+  const std::vector<std::string> &face_names() const { return _face_names; }
+
+  std::size_t component_count() const
+  {
+    return _component_begin.empty() ? 0 : _component_begin.size() - 1;
+  }
+  // Input component of the triangle nearest to p, or any_component when
+  // the input has no triangle to sample
+  std::size_t component_at(const Point &p) const;
+
+  // Write one value per attribute into out (sized to the attribute count),
+  // sampled on the given input component
+  void sample_vertex(const Point &p, std::size_t component,
+                     double *out) const;
+  void sample_face(const Point &centroid, std::size_t component,
+                   double *out) const;
+
+private:
+  std::size_t locate(const Point &p, std::size_t component,
+                     Point &closest) const;
+
+  std::vector<std::string> _vertex_names;
+  std::vector<std::string> _face_names;
+  std::vector<std::vector<double>> _vertex_values; // [attribute][input row]
+  std::vector<std::vector<double>> _face_values;   // [attribute][input row]
+  // Soup entries, grouped by component: component c holds the entries
+  // [_component_begin[c], _component_begin[c + 1])
+  std::vector<std::array<int, 3>> _triangle_rows; // vertex rows per soup entry
+  std::vector<std::size_t> _face_rows;            // input face row per entry
+  std::vector<Triangle> _triangles;
+  std::vector<std::size_t> _component_begin;
+  std::unique_ptr<SoupTree> _tree;
+  // One tree per component; empty when the input is a single component
+  std::vector<std::unique_ptr<SoupTree>> _component_trees;
+};
+
+#endif // ATTRIBUTES_H
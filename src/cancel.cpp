@@ -0,0 +1,93 @@
+#include "cancel.h"
+#include <chrono>
+
+namespace LoopCGAL
+{
+    namespace
+    {
+        thread_local CancelToken *t_token = nullptr;
+        thread_local std::chrono::steady_clock::time_point t_last_poll;
+        constexpr std::chrono::milliseconds kPollInterval(100);
+
+        // Threads that run Python code and so may take the GIL; the
+        // workers of parallel_for never do.
+        bool python_thread()
+        {
+            return PyGILState_GetThisThreadState() != nullptr;
+        }
+
+        // Needs the GIL
+        void check_signals()
+        {
+            if (PyErr_CheckSignals() != 0)
+                throw pybind11::error_already_set();
+        }
+
+        // Needs the GIL
+        void report_progress(CancelToken &token, const char *stage,
+                             double fraction)
+        {
+            check_signals();
+            if (token.callback() && !token.cancelled())
+            {
+                pybind11::object keep_going = token.callback()(stage, fraction);
+                if (!keep_going.is_none() && !keep_going.cast<bool>())
+                    token.cancel();
+            }
+        }
+    } // namespace
+
+    ScopedCancelToken::ScopedCancelToken(CancelToken *token)
+        : _previous(t_token)
+    {
+        t_token = token;
+    }
+
+    ScopedCancelToken::~ScopedCancelToken() { t_token = _previous; }
+
+    CancelToken *current_cancel_token() { return t_token; }
+
+    void check_cancelled()
+    {
+        if (t_token && t_token->cancelled())
+            throw CancelledError();
+    }
+
+    void checkpoint(const char *stage, double fraction)
+    {
+        CancelToken *token = t_token;
+        if (!token)
+            return;
+        if (PyGILState_Check())
+        {
+            {
+                pybind11::gil_scoped_release yield;
+            }
+            report_progress(*token, stage, fraction);
+        }
+        else if (python_thread())
+        {
+            pybind11::gil_scoped_acquire gil;
+            report_progress(*token, stage, fraction);
+        }
+        check_cancelled();
+    }
+
+    void poll_cancelled()
+    {
+        check_cancelled();
+        if (!t_token || !python_thread())
+            return;
+        const auto now = std::chrono::steady_clock::now();
+        if (now - t_last_poll < kPollInterval)
+            return;
+        t_last_poll = now;
+        if (PyGILState_Check())
+            check_signals();
+        else
+        {
+            pybind11::gil_scoped_acquire gil;
+            check_signals();
+        }
+    }
+}
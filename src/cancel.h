@@ -0,0 +1,95 @@
+#ifndef CANCEL_H
+#define CANCEL_H
+#include <pybind11/pybind11.h>
+#include <atomic>
+#include <stdexcept>
+#include <utility>
+
+namespace LoopCGAL
+{
+    // Thrown at a checkpoint once the current call has been cancelled;
+    // surfaces in Python as loop_cgal.CancelledError. Everything the call
+    // built is released while the exception unwinds.
+    class CancelledError : public std::runtime_error
+    {
+    public:
+        CancelledError() : std::runtime_error("Operation cancelled.") {}
+    };
+
+    // Shared between Python and a running call. cancel() may be called
+    // from any thread. The optional callback receives (stage, fraction)
+    // at each checkpoint of the calling thread, fraction being the
+    // progress within that stage, and cancels the call by returning False.
+    class CancelToken
+    {
+    public:
+        CancelToken() = default;
+        explicit CancelToken(pybind11::object callback)
+            : _callback(std::move(callback)) {}
+        CancelToken(const CancelToken &) = delete;
+        CancelToken &operator=(const CancelToken &) = delete;
+
+        void cancel() { _cancelled.store(true, std::memory_order_relaxed); }
+        void reset() { _cancelled.store(false, std::memory_order_relaxed); }
+        bool cancelled() const
+        {
+            return _cancelled.load(std::memory_order_relaxed);
+        }
+        const pybind11::object &callback() const { return _callback; }
+
+    private:
+        std::atomic<bool> _cancelled{false};
+        pybind11::object _callback;
+    };
+
+    // Makes token the current token of the calling thread until the scope
+    // ends, like ScopedLogLevel does for the log level. nullptr is allowed.
+    class ScopedCancelToken
+    {
+    public:
+        explicit ScopedCancelToken(CancelToken *token);
+        ScopedCancelToken(const ScopedCancelToken &) = delete;
+        ScopedCancelToken &operator=(const ScopedCancelToken &) = delete;
+        ~ScopedCancelToken();
+
+    private:
+        CancelToken *_previous;
+    };
+
+    CancelToken *current_cancel_token();
+
+    // Throws CancelledError if the current token is cancelled. A single
+    // atomic load; safe on worker threads and without the GIL.
+    void check_cancelled();
+
+    // Checkpoint between phases on the calling thread. Forwards pending
+    // signals (KeyboardInterrupt) and runs the progress callback, taking
+    // the GIL for just that when the call runs without it; with the GIL
+    // held it first yields it so another thread can call cancel().
+    void checkpoint(const char *stage, double fraction = 0.0);
+
+    // check_cancelled(), plus a signal check at most every 100 ms on the
+    // calling thread (taking the GIL if released), so KeyboardInterrupt
+    // reaches a long CGAL call without waiting for its next phase.
+    void poll_cancelled();
+
+    // Wraps a CGAL corefinement visitor so that its progress hooks (called
+    // by CGAL >= 5.3; never by older versions) check for cancellation.
+    template <typename Base>
+    struct CancelVisitor : public Base
+    {
+        void progress_filtering_intersections(double) const
+        {
+            poll_cancelled();
+        }
+        void triangulating_faces_step() const { poll_cancelled(); }
+        void edge_face_intersections_step() const { poll_cancelled(); }
+        void intersection_of_coplanar_faces_step() const
+        {
+            poll_cancelled();
+        }
+        void start_building_output() const { poll_cancelled(); }
+    };
+}
+
+#endif // CANCEL_H
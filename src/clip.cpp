@@ -1,71 +1,76 @@
 #include "clip.h"
+#include "arrayview.h"
+#include "attributes.h"
+#include "cancel.h"
+#include "globals.h"
+#include "memory.h"
 #include "meshutils.h"
 #include "numpymesh.h"
+#include "region.h"
+#include "remeshcache.h"
 #include <CGAL/Polygon_mesh_processing/bbox.h>
 #include <CGAL/Polygon_mesh_processing/clip.h>
 #include <CGAL/Polygon_mesh_processing/corefinement.h>
+#include <CGAL/Polygon_mesh_processing/measure.h>
 #include <CGAL/Polygon_mesh_processing/merge_border_vertices.h>
 #include <CGAL/Polygon_mesh_processing/remesh.h>
 #include <CGAL/Polygon_mesh_processing/self_intersections.h>
 #include <CGAL/Polygon_mesh_processing/triangulate_faces.h>
 #include <CGAL/Simple_cartesian.h>
 #include <CGAL/Surface_mesh.h>
+#include <CGAL/boost/graph/helpers.h>
 #include <CGAL/boost/graph/properties.h>
 #include <CGAL/version.h>
+#include <optional>
+#include <set>
+#include <vector>
 
 namespace PMP = CGAL::Polygon_mesh_processing;
 using face_descriptor = TriangleMesh::Face_index;
 
 TriangleMesh load_mesh(NumpyMesh mesh, bool verbose) {
+  LoopCGAL::ScopedLogLevel log_scope(verbose);
   TriangleMesh tm;
-  auto vertices_buf = mesh.vertices.unchecked<2>();
-  auto triangles_buf = mesh.triangles.unchecked<2>();
-  std::vector<TriangleMesh::Vertex_index> vertex_indices;
-
-  if (verbose) {
-    std::cout << "Loading mesh with " << vertices_buf.shape(0)
-              << " vertices and " << triangles_buf.shape(0) << " triangles."
-              << std::endl;
-  }
+
+  LOOPCGAL_DEBUG("Loading mesh with " << mesh.vertices.shape(0)
+                 << " vertices and " << mesh_triangle_count(mesh)
+                 << " triangles.");
+
+  // The result of an earlier call is already a Surface_mesh
+  if (mesh.exported && !LoopCGAL::get_spatial_ordering())
+    return mesh.exported->mesh();
 
   // Assemble CGAL mesh objects from numpy/pybind11 arrays
-  for (ssize_t i = 0; i < vertices_buf.shape(0); ++i) {
-    vertex_indices.push_back(tm.add_vertex(
-        Point(vertices_buf(i, 0), vertices_buf(i, 1), vertices_buf(i, 2))));
-  }
-  for (ssize_t i = 0; i < triangles_buf.shape(0); ++i) {
-    tm.add_face(vertex_indices[triangles_buf(i, 0)],
-                vertex_indices[triangles_buf(i, 1)],
-                vertex_indices[triangles_buf(i, 2)]);
-  }
+  load_arrays(tm, mesh.vertices, mesh_triangles(mesh), mesh_offsets(mesh),
+              LoopCGAL::get_spatial_ordering());
 
-  if (verbose) {
-    std::cout << "Loaded mesh with " << tm.number_of_vertices()
-              << " vertices and " << tm.number_of_faces() << " faces."
-              << std::endl;
-  }
+  LOOPCGAL_DEBUG("Loaded mesh with " << tm.number_of_vertices()
+                 << " vertices and " << tm.number_of_faces() << " faces.");
 
   return tm;
 }
 
 Plane load_plane(NumpyPlane plane, bool verbose) {
+  LoopCGAL::ScopedLogLevel log_scope(verbose);
   auto normal_buf = plane.normal.unchecked<1>();
   auto point_buf = plane.origin.unchecked<1>();
-  if (verbose) {
-    std::cout << "Loading plane with normal (" << normal_buf(0) << ", "
-              << normal_buf(1) << ", " << normal_buf(2) << ") and point ("
-              << point_buf(0) << ", " << point_buf(1) << ", " << point_buf(2)
-              << ")." << std::endl;
-  }
+  LOOPCGAL_DEBUG("Loading plane with normal ("
+                 << normal_buf(0) << ", " << normal_buf(1) << ", "
+                 << normal_buf(2) << ") and point (" << point_buf(0) << ", "
+                 << point_buf(1) << ", " << point_buf(2) << ").");
   return Plane(Point(point_buf(0), point_buf(1), point_buf(2)),
                Vector(normal_buf(0), normal_buf(1), normal_buf(2)));
 }
 // -----------------------------------------------------------------------------
-//  Robust remesher that bails out on pathological micro‑patches
+//  Robust remesher that bails out on pathological micro‑patches.
+//  With convergence_tolerance > 0, number_of_iterations is an upper bound and
+//  the loop stops once the edge-length statistics settle. Returns the number
+//  of remeshing iterations performed.
 // -----------------------------------------------------------------------------
-void refine_mesh(TriangleMesh &mesh, bool split_long_edges, bool verbose,
-                 double target_edge_length, int number_of_iterations,
-                 bool protect_constraints, bool relax_constraints) {
+int refine_mesh(TriangleMesh &mesh, bool split_long_edges, bool verbose,
+                double target_edge_length, int number_of_iterations,
+                bool protect_constraints, bool relax_constraints,
+                double convergence_tolerance) {
   // ------------------------------------------------------------------
   // 0.  Guard‑rail: sensible target length w.r.t. bbox
   // ------------------------------------------------------------------
@@ -75,10 +80,9 @@ void refine_mesh(TriangleMesh &mesh, bool split_long_edges, bool verbose,
                                      CGAL::square(bb.zmax() - bb.zmin()));
   PMP::remove_isolated_vertices(mesh);
   if (target_edge_length < 1e-4 * bbox_diag) {
-    if (verbose)
-      std::cout << "  ! target_edge_length (" << target_edge_length
-                << ") too small – skipping remesh\n";
-    return;
+    LOOPCGAL_DEBUG("  ! target_edge_length (" << target_edge_length
+                << ") too small – skipping remesh");
+    return 0;
   }
 
   // ------------------------------------------------------------------
@@ -90,12 +94,11 @@ void refine_mesh(TriangleMesh &mesh, bool split_long_edges, bool verbose,
     min_e = std::min(min_e, l);
     max_e = std::max(max_e, l);
   }
-  if (verbose)
-    std::cout << "      edge length range: [" << min_e << ", " << max_e
-              << "]  target = " << target_edge_length << '\n';
+  LOOPCGAL_DEBUG("      edge length range: [" << min_e << ", " << max_e
+                 << "]  target = " << target_edge_length);
 
-  if (!CGAL::is_valid_polygon_mesh(mesh, verbose) && verbose)
-    std::cout << "      ! mesh is not a valid polygon mesh\n";
+  MeshState state;
+  validate_mesh(mesh, state, ValidationStage::Intermediate, "mesh");
 
   // ------------------------------------------------------------------
   // 2.  Abort when self‑intersections remain
@@ -116,16 +119,21 @@ void refine_mesh(TriangleMesh &mesh, bool split_long_edges, bool verbose,
   if (n_faces < 40) {
     if (split_long_edges)
       PMP::split_long_edges(edges(mesh), target_edge_length, mesh);
-    if (verbose)
-      std::cout << "      → tiny patch (" << n_faces
-                << " faces) – isotropic remesh skipped\n";
-    return;
+    LOOPCGAL_DEBUG("      → tiny patch (" << n_faces
+                << " faces) – isotropic remesh skipped");
+    return 0;
   }
 
   // ------------------------------------------------------------------
   // 4.  Normal isotropic remeshing loop
   // ------------------------------------------------------------------
-  for (int iter = 0; iter < number_of_iterations; ++iter) {
+  const bool check_convergence = convergence_tolerance > 0.0;
+  RemeshStats stats;
+  if (check_convergence)
+    stats = remesh_stats(mesh, target_edge_length);
+  int iter = 0;
+  while (iter < number_of_iterations) {
+    LoopCGAL::checkpoint("remesh", double(iter) / number_of_iterations);
     if (split_long_edges)
       PMP::split_long_edges(edges(mesh), target_edge_length, mesh);
 
@@ -139,13 +147,196 @@ void refine_mesh(TriangleMesh &mesh, bool split_long_edges, bool verbose,
                 CGAL::make_boolean_property_map(border_edges))
             .protect_constraints(protect_constraints)
             .relax_constraints(relax_constraints));
+    ++iter;
+
+    if (check_convergence) {
+      RemeshStats current = remesh_stats(mesh, target_edge_length);
+      const bool converged =
+          remesh_converged(stats, current, convergence_tolerance);
+      stats = current;
+      if (converged)
+        break;
+    }
   }
 
-  if (verbose)
-    std::cout << "Refined mesh → " << mesh.number_of_vertices() << " V, "
-              << mesh.number_of_faces() << " F\n";
-  if (!CGAL::is_valid_polygon_mesh(mesh, verbose) && verbose)
-    std::cout << "      ! mesh is not a valid polygon mesh after remeshing\n";
+  LOOPCGAL_DEBUG("Refined mesh → " << mesh.number_of_vertices() << " V, "
+                 << mesh.number_of_faces() << " F in " << iter
+                 << " iteration(s)");
+  state.touch();
+  validate_mesh(mesh, state, ValidationStage::Intermediate,
+                "mesh after remeshing");
+  return iter;
+}
+
+// Remesh cache key of the pre-clip remesh of input, when the cache is on.
+// Computed from the arrays, so a hit skips load_mesh as well.
+static std::optional<LoopCGAL::RemeshCacheKey>
+input_cache_key(const NumpyMesh &input, double target_edge_length,
+                int number_of_iterations, bool protect_constraints,
+                bool relax_constraints, double convergence_tolerance) {
+  if (!LoopCGAL::remesh_cache_enabled())
+    return std::nullopt;
+  return LoopCGAL::remesh_cache_key(
+      input, {target_edge_length, double(number_of_iterations),
+              double(protect_constraints), double(relax_constraints),
+              convergence_tolerance,
+              double(LoopCGAL::get_spatial_ordering())});
+}
+
+// Loads the input surface, or takes its refined form from the remesh cache;
+// returns true on a cache hit.
+static bool load_input(TriangleMesh &mesh, const NumpyMesh &input,
+                       const std::optional<LoopCGAL::RemeshCacheKey> &key,
+                       bool verbose) {
+  if (key && LoopCGAL::remesh_cache_lookup(*key, mesh)) {
+    LOOPCGAL_DEBUG("Reusing cached remesh of the input surface.");
+    return true;
+  }
+  mesh = load_mesh(input, verbose);
+  return false;
+}
+
+// Pre-clip remesh of a loaded input surface, stored in the remesh cache
+// under key. The stored copy is compacted, so mesh is compacted as well:
+// a later hit then continues from exactly the same mesh as this call.
+static void refine_input(TriangleMesh &mesh,
+                         const std::optional<LoopCGAL::RemeshCacheKey> &key,
+                         bool verbose, double target_edge_length,
+                         int number_of_iterations, bool protect_constraints,
+                         bool relax_constraints,
+                         double convergence_tolerance) {
+  refine_mesh(mesh, true, verbose, target_edge_length, number_of_iterations,
+              protect_constraints, relax_constraints, convergence_tolerance);
+  if (!key)
+    return;
+  mesh.collect_garbage();
+  LoopCGAL::remesh_cache_store(*key, mesh);
+}
+
+static int remesh_constrained(TriangleMesh &tm,
+                              std::set<TriangleMesh::Edge_index> &constrained,
+                              std::set<TriangleMesh::Vertex_index> &fixed,
+                              double target_edge_length,
+                              int number_of_iterations, bool relax_constraints,
+                              bool protect_constraints,
+                              double convergence_tolerance);
+
+// Remeshes the roi of a region clip like refine_mesh does a whole mesh: its
+// border edges are the constraints the caller's flags apply to. The seam
+// vertices are fixed on top, so the roi still welds onto the rest.
+static void remesh_region(MeshRegion &region, double target_edge_length,
+                          int number_of_iterations, bool protect_constraints,
+                          bool relax_constraints,
+                          double convergence_tolerance) {
+  TriangleMesh &roi = region.roi;
+  std::set<TriangleMesh::Vertex_index> seam_vertices;
+  for (auto v : roi.vertices())
+    if (region.seam[v] != TriangleMesh::null_vertex())
+      seam_vertices.insert(v);
+  std::set<TriangleMesh::Edge_index> constrained = collect_border_edges(roi);
+  if (protect_constraints) {
+    // Protected edges must be short enough for the remesher to keep them;
+    // extract_region already split the seam.
+    const double max_length = 4.0 / 3.0 * target_edge_length;
+    std::vector<TriangleMesh::Edge_index> long_edges;
+    for (auto e : constrained)
+      if (PMP::edge_length(e, roi) > max_length)
+        long_edges.push_back(e);
+    PMP::split_long_edges(long_edges, max_length, roi,
+                          CGAL::parameters::edge_is_constrained_map(
+                              CGAL::make_boolean_property_map(constrained)));
+  }
+  remesh_constrained(roi, constrained, seam_vertices, target_edge_length,
+                     number_of_iterations, relax_constraints,
+                     protect_constraints, convergence_tolerance);
+}
+
+// Clips only the faces of tm near the clipper: they are cut out, remeshed,
+// clipped and cleaned on their own, and welded back onto the untouched
+// rest, whose seam vertices never move. Returns false when the region
+// cannot reproduce a whole-mesh clip; tm then still describes the same
+// surface, possibly with some seam edges split.
+static bool clip_region(TriangleMesh &tm, TriangleMesh &clipper,
+                        double target_edge_length, bool remesh_before_clipping,
+                        bool remesh_after_clipping,
+                        bool remove_degenerate_faces,
+                        int number_of_iterations, bool protect_constraints,
+                        bool relax_constraints,
+                        double convergence_tolerance) {
+  const CGAL::Bbox_3 tm_box = PMP::bbox(tm);
+  const double bbox_diag =
+      std::sqrt(CGAL::square(tm_box.xmax() - tm_box.xmin()) +
+                CGAL::square(tm_box.ymax() - tm_box.ymin()) +
+                CGAL::square(tm_box.zmax() - tm_box.zmin()));
+  const bool remesh = target_edge_length >= 1e-4 * bbox_diag;
+  remesh_before_clipping = remesh_before_clipping && remesh;
+  remesh_after_clipping = remesh_after_clipping && remesh;
+
+  // The margin keeps the seam a couple of target edges away from the cut
+  const double margin = 2.0 * target_edge_length;
+  const CGAL::Bbox_3 c = PMP::bbox(clipper);
+  const CGAL::Bbox_3 box(c.xmin() - margin, c.ymin() - margin,
+                         c.zmin() - margin, c.xmax() + margin,
+                         c.ymax() + margin, c.zmax() + margin);
+  MeshRegion region;
+  const double max_seam_length =
+      remesh_before_clipping || remesh_after_clipping
+          ? 4.0 / 3.0 * target_edge_length
+          : 0.0;
+  if (!extract_region(tm, box, max_seam_length, region)) {
+    LOOPCGAL_DEBUG("No proper clip region; clipping the whole mesh.");
+    return false;
+  }
+  TriangleMesh &roi = region.roi;
+  LOOPCGAL_DEBUG("Clip region holds " << roi.number_of_faces() << " of "
+                 << tm.number_of_faces() << " faces.");
+
+  if (remesh_before_clipping)
+    remesh_region(region, target_edge_length, number_of_iterations,
+                  protect_constraints, relax_constraints,
+                  convergence_tolerance);
+  TriangleMesh merged;
+  if (!PMP::do_intersect(roi, clipper)) {
+    // Nothing is clipped, but the roi may have been remeshed
+    if (!merge_region(region, DetachedComponents::Keep, merged)) {
+      LOOPCGAL_DEBUG("Clip region cannot be merged; clipping the whole mesh.");
+      return false;
+    }
+    LOOPCGAL_DEBUG("Meshes do not intersect. Returning tm.");
+    tm = std::move(merged);
+    return true;
+  }
+  LoopCGAL::checkpoint("clip");
+  LoopCGAL::CancelVisitor<PMP::Corefinement::Default_visitor<TriangleMesh>>
+      visitor;
+  if (!PMP::clip(roi, clipper, CGAL::parameters::visitor(visitor))) {
+    LOOPCGAL_WARNING("Clipping the region failed; clipping the whole mesh.");
+    return false;
+  }
+  LoopCGAL::checkpoint("clip", 1.0);
+  if (remesh_after_clipping) {
+    stitch_mesh(roi);
+    remesh_region(region, target_edge_length, number_of_iterations,
+                  protect_constraints, relax_constraints,
+                  convergence_tolerance);
+  }
+  if (remove_degenerate_faces) {
+    LoopCGAL::checkpoint("cleanup");
+    if (!clean_degenerate_faces(roi, collect_border_edges(roi)))
+      LOOPCGAL_WARNING("Removing degenerate faces failed.");
+  }
+
+  // Without a closed clipper the side of a component that never meets it
+  // is not known here, so such components send the clip back to tm.
+  if (!merge_region(region,
+                    CGAL::is_closed(clipper) ? DetachedComponents::Drop
+                                             : DetachedComponents::Fail,
+                    merged)) {
+    LOOPCGAL_DEBUG("Clip region cannot be merged; clipping the whole mesh.");
+    return false;
+  }
+  tm = std::move(merged);
+  return true;
 }
 
 bool plane_cuts_mesh(const TriangleMesh &mesh, const Plane &P) {
@@ -169,114 +360,100 @@ NumpyMesh clip_plane(NumpyMesh tm, NumpyPlane clipper,
                      bool remesh_after_clipping, bool remove_degenerate_faces,
                      double duplicate_vertex_threshold, double area_threshold,
                      bool protect_constraints, bool relax_constraints,
-                     bool verbose) {
+                     bool verbose, double convergence_tolerance) {
+  LoopCGAL::ScopedLogLevel log_scope(verbose);
+  LoopCGAL::MemoryCall memory("clip_plane");
+  memory.phase("load");
   int number_of_iterations = 3; // Number of remeshing iterations
-  if (verbose) {
-    std::cout << "Starting clipping process." << std::endl;
-    std::cout << "Loading data from NumpyMesh." << std::endl;
-  }
-  TriangleMesh _tm = load_mesh(tm, verbose);
-  if (verbose) {
-    std::cout << "Loaded mesh." << std::endl;
-  }
+  LOOPCGAL_DEBUG("Starting clipping process.");
+  LOOPCGAL_DEBUG("Loading data from NumpyMesh.");
+  const auto cache_key =
+      remesh_before_clipping
+          ? input_cache_key(tm, target_edge_length, number_of_iterations,
+                            protect_constraints, relax_constraints,
+                            convergence_tolerance)
+          : std::nullopt;
+  TriangleMesh _tm;
+  const bool cached = load_input(_tm, tm, cache_key, verbose);
+  AttributeTransfer attributes(tm);
+  LOOPCGAL_DEBUG("Loaded mesh.");
+  MeshState tm_state;
+  if (!cached)
+    validate_mesh(_tm, tm_state, ValidationStage::Input, "tm");
   Plane _clipper = load_plane(clipper, verbose);
-  if (verbose) {
-    std::cout << "Loaded plane." << std::endl;
-  }
-  if (remesh_before_clipping) {
-    if (verbose) {
-      std::cout << "Remeshing before clipping." << std::endl;
-    }
-    refine_mesh(_tm, true, verbose, target_edge_length, number_of_iterations,
-                protect_constraints, relax_constraints);
-    // number_of_iterations);
-
-    if (verbose) {
-      std::cout << "Remeshing before clipping done." << std::endl;
-    }
+  LOOPCGAL_DEBUG("Loaded plane.");
+  LoopCGAL::checkpoint("load", 1.0);
+  // The CGAL phases run without the GIL; checkpoints take it back only
+  // for the progress callback and signals.
+  std::optional<pybind11::gil_scoped_release> release(std::in_place);
+  if (remesh_before_clipping && !cached) {
+    memory.phase("remesh_before");
+    LOOPCGAL_DEBUG("Remeshing before clipping.");
+    refine_input(_tm, cache_key, verbose, target_edge_length,
+                 number_of_iterations, protect_constraints, relax_constraints,
+                 convergence_tolerance);
+
+    LOOPCGAL_DEBUG("Remeshing before clipping done.");
   }
 
   // make sure the meshes actually intersect. If they don't, just return mesh 1
+  memory.phase("clip");
   bool intersection = plane_cuts_mesh(_tm, _clipper);
+  LoopCGAL::checkpoint("clip");
 
   if (intersection) {
     // Clip tm with clipper
-    if (verbose) {
-      std::cout << "Clipping tm with clipper." << std::endl;
-    }
+    LOOPCGAL_DEBUG("Clipping tm with clipper.");
     bool flag = PMP::clip(_tm, _clipper, CGAL::parameters::clip_volume(false));
     // PMP::triangulate_faces(_tm);
-    if (verbose) {
-      std::cout << "Clipping done." << std::endl;
-    }
+    LOOPCGAL_DEBUG("Clipping done.");
+    LoopCGAL::checkpoint("clip", 1.0);
     if (!flag) {
-      std::cerr << "Clipping failed." << std::endl;
+      LOOPCGAL_ERROR("Clipping failed.");
+      release.reset();
       return {};
     } else {
       if (remesh_after_clipping) {
-
-        if (verbose) {
-          std::cout << "Remeshing after clipping." << std::endl;
-        }
-        if (verbose)
-          std::cout << "  – stitching borders…" << std::endl;
-
-        PMP::stitch_borders(_tm);
-        if (verbose)
-          std::cout << "  – merging dup vertices…" << std::endl;
-        PMP::merge_duplicated_vertices_in_boundary_cycles(_tm);
-        if (verbose)
-          std::cout << "  – isotropic remeshing…" << std::endl;
+        memory.phase("remesh_after");
+        LOOPCGAL_DEBUG("Remeshing after clipping.");
+        stitch_mesh(_tm);
+        LOOPCGAL_DEBUG("  – isotropic remeshing…");
         refine_mesh(_tm, true, verbose, target_edge_length,
                     number_of_iterations, protect_constraints,
-                    relax_constraints);
+                    relax_constraints, convergence_tolerance);
 
-        if (verbose) {
-          std::cout << "Remeshing after clipping done." << std::endl;
-        }
+        LOOPCGAL_DEBUG("Remeshing after clipping done.");
       }
       if (remove_degenerate_faces) {
-        if (verbose) {
-          std::cout << "Removing degenerate faces." << std::endl;
-        }
+        memory.phase("cleanup");
+        LoopCGAL::checkpoint("cleanup");
+        LOOPCGAL_DEBUG("Removing degenerate faces.");
         std::set<TriangleMesh::Edge_index> protected_edges =
             collect_border_edges(_tm);
-#if CGAL_VERSION_NR >= 1060000000
-        bool beautify_flag = PMP::remove_almost_degenerate_faces(
-            faces(_tm), _tm,
-            CGAL::parameters::edge_is_constrained_map(
-                CGAL::make_boolean_property_map(protected_edges)));
-#else
-        bool beautify_flag = PMP::remove_degenerate_faces(
-            faces(_tm), _tm,
-            CGAL::parameters::edge_is_constrained_map(
-                CGAL::make_boolean_property_map(protected_edges)));
-#endif
+        bool beautify_flag = clean_degenerate_faces(_tm, protected_edges);
         if (!beautify_flag) {
-          std::cerr << "Removing degenerate faces failed." << std::endl;
-        }
-        if (verbose) {
-          std::cout << "Removing degenerate faces done." << std::endl;
+          LOOPCGAL_WARNING("Removing degenerate faces failed.");
         }
+        LOOPCGAL_DEBUG("Removing degenerate faces done.");
       }
     }
   } else {
-    if (verbose)
-      std::cout << "Meshes do not intersect. Returning tm." << std::endl;
-  }
-  if (verbose) {
-    std::cout << "Clipping done." << std::endl;
+    LOOPCGAL_DEBUG("Meshes do not intersect. Returning tm.");
   }
+  LOOPCGAL_DEBUG("Clipping done.");
 
   // store the result in a numpymesh object for sending back to Python
 
+  memory.phase("export");
+  LoopCGAL::checkpoint("export");
+  _tm.collect_garbage(); // compact freed slots before the export walk
+  release.reset();
   NumpyMesh result =
-      export_mesh(_tm, area_threshold, duplicate_vertex_threshold);
-  if (verbose) {
-    std::cout << "Exported clipped mesh with " << result.vertices.shape(0)
-              << " vertices and " << result.triangles.shape(0) << " triangles."
-              << std::endl;
-  }
+      export_mesh(std::move(_tm), area_threshold, duplicate_vertex_threshold,
+                  &attributes);
+  LOOPCGAL_DEBUG("Exported clipped mesh with "
+                 << result.vertices.shape(0) << " vertices and "
+                 << mesh_triangle_count(result) << " triangles.");
   return result;
 }
 NumpyMesh clip_surface(NumpyMesh tm, NumpyMesh clipper,
@@ -284,147 +461,204 @@ NumpyMesh clip_surface(NumpyMesh tm, NumpyMesh clipper,
                        bool remesh_after_clipping, bool remove_degenerate_faces,
                        double duplicate_vertex_threshold, double area_threshold,
                        bool protect_constraints, bool relax_constraints,
-                       bool verbose) {
-  if (verbose) {
-    std::cout << "Starting clipping process." << std::endl;
-    std::cout << "Loading data from NumpyMesh." << std::endl;
-  }
-  TriangleMesh _tm = load_mesh(tm, verbose);
+                       bool verbose, double convergence_tolerance,
+                       bool region_of_interest) {
+  LoopCGAL::ScopedLogLevel log_scope(verbose);
+  LoopCGAL::MemoryCall memory("clip_surface");
+  memory.phase("load");
+  LOOPCGAL_DEBUG("Starting clipping process.");
+  LOOPCGAL_DEBUG("Loading data from NumpyMesh.");
+  // Parameters for isotropic remeshing
+  const unsigned int number_of_iterations = 3; // Number of remeshing iterations
+  // A region clip remeshes only part of tm, so it never starts from the
+  // cached whole-mesh remesh; it may still fall back to one below.
+  const auto cache_key =
+      remesh_before_clipping
+          ? input_cache_key(tm, target_edge_length, number_of_iterations,
+                            protect_constraints, relax_constraints,
+                            convergence_tolerance)
+          : std::nullopt;
+  TriangleMesh _tm;
+  const bool cached =
+      load_input(_tm, tm, region_of_interest ? std::nullopt : cache_key,
+                 verbose);
   TriangleMesh _clipper = load_mesh(clipper, verbose);
-  if (verbose) {
-    std::cout << "Loaded meshes." << std::endl;
-  }
+  AttributeTransfer attributes(tm);
+  LOOPCGAL_DEBUG("Loaded meshes.");
   PMP::remove_isolated_vertices(_tm);
   PMP::remove_isolated_vertices(_clipper);
-  if (!CGAL::is_valid_polygon_mesh(_tm, verbose)) {
-    std::cerr << "tm is invalid!" << std::endl;
-    if (verbose)
-    {
-      CGAL::is_valid_polygon_mesh(_tm, true);
-    }
-  }
-  if (!CGAL::is_valid_polygon_mesh(_clipper, verbose)) {
-    std::cerr << "clipper is invalid!" << std::endl;
-  }
-  // Parameters for isotropic remeshing
-  const unsigned int number_of_iterations = 3; // Number of remeshing iterations
-  if (remesh_before_clipping) {
-    if (verbose) {
-      std::cout << "Remeshing before clipping." << std::endl;
-    }
-    refine_mesh(_tm, true, verbose, target_edge_length, number_of_iterations,
-                protect_constraints, relax_constraints);
+  MeshState tm_state, clipper_state;
+  if (!cached)
+    validate_mesh(_tm, tm_state, ValidationStage::Input, "tm");
+  validate_mesh(_clipper, clipper_state, ValidationStage::Input, "clipper");
+  LoopCGAL::checkpoint("load", 1.0);
+  // The CGAL phases run without the GIL; checkpoints take it back only
+  // for the progress callback and signals.
+  std::optional<pybind11::gil_scoped_release> release(std::in_place);
+  if (region_of_interest)
+    memory.phase("region");
+  const bool region_clipped =
+      region_of_interest &&
+      clip_region(_tm, _clipper, target_edge_length, remesh_before_clipping,
+                  remesh_after_clipping, remove_degenerate_faces,
+                  number_of_iterations, protect_constraints,
+                  relax_constraints, convergence_tolerance);
+  if (remesh_before_clipping && !region_clipped && !cached &&
+      !(region_of_interest && cache_key &&
+        LoopCGAL::remesh_cache_lookup(*cache_key, _tm))) {
+    memory.phase("remesh_before");
+    LOOPCGAL_DEBUG("Remeshing before clipping.");
+    // After a failed region clip _tm may have seam edges split, so its
+    // remesh is not the one cache_key stands for and is not stored.
+    refine_input(_tm, region_of_interest ? std::nullopt : cache_key, verbose,
+                 target_edge_length, number_of_iterations,
+                 protect_constraints, relax_constraints,
+                 convergence_tolerance);
     // refine_mesh(_clipper, true, verbose, target_edge_length,
     //             number_of_iterations, protect_constraints,
     //             relax_constraints);
 
-    if (verbose) {
-      std::cout << "Remeshing before clipping done." << std::endl;
-    }
+    LOOPCGAL_DEBUG("Remeshing before clipping done.");
   }
 
   // make sure the meshes actually intersect. If they don't, just return mesh 1
-  bool intersection = PMP::do_intersect(_tm, _clipper);
+  memory.phase("clip");
+  bool intersection = !region_clipped && PMP::do_intersect(_tm, _clipper);
+  LoopCGAL::checkpoint("clip");
   if (intersection) {
     // Clip tm with clipper
-    if (verbose) {
-      std::cout << "Clipping tm with clipper." << std::endl;
-    }
-    bool flag = PMP::clip(_tm, _clipper);
+    LOOPCGAL_DEBUG("Clipping tm with clipper.");
+    LoopCGAL::CancelVisitor<PMP::Corefinement::Default_visitor<TriangleMesh>>
+        visitor;
+    bool flag = PMP::clip(_tm, _clipper, CGAL::parameters::visitor(visitor));
     // PMP::triangulate_faces(_tm);
-    if (verbose) {
-      std::cout << "Clipping done." << std::endl;
-    }
+    LOOPCGAL_DEBUG("Clipping done.");
+    LoopCGAL::checkpoint("clip", 1.0);
     if (!flag) {
-      std::cerr << "Clipping failed." << std::endl;
+      LOOPCGAL_ERROR("Clipping failed.");
+      release.reset();
       return {};
     } else {
       if (remesh_after_clipping) {
-
-        if (verbose) {
-          std::cout << "Remeshing after clipping." << std::endl;
-        }
-        if (verbose)
-          std::cout << "  – stitching borders…" << std::endl;
-        PMP::stitch_borders(_tm);
-        if (verbose)
-          std::cout << "  – merging dup vertices…" << std::endl;
-        PMP::merge_duplicated_vertices_in_boundary_cycles(_tm);
-        if (verbose)
-          std::cout << "  – isotropic remeshing…" << std::endl;
+        memory.phase("remesh_after");
+        LOOPCGAL_DEBUG("Remeshing after clipping.");
+        stitch_mesh(_tm);
+        LOOPCGAL_DEBUG("  – isotropic remeshing…");
         refine_mesh(_tm, true, verbose, target_edge_length,
                     number_of_iterations, protect_constraints,
-                    relax_constraints);
+                    relax_constraints, convergence_tolerance);
 
-        if (verbose) {
-          std::cout << "Remeshing after clipping done." << std::endl;
-        }
+        LOOPCGAL_DEBUG("Remeshing after clipping done.");
       }
       if (remove_degenerate_faces) {
-        if (verbose) {
-          std::cout << "Removing degenerate faces." << std::endl;
-        }
+        memory.phase("cleanup");
+        LoopCGAL::checkpoint("cleanup");
+        LOOPCGAL_DEBUG("Removing degenerate faces.");
         std::set<TriangleMesh::Edge_index> protected_edges =
             collect_border_edges(_tm);
 
-#if CGAL_VERSION_NR >= 1060000000
-        bool beautify_flag = PMP::remove_almost_degenerate_faces(
-            faces(_tm), _tm,
-            CGAL::parameters::edge_is_constrained_map(
-                CGAL::make_boolean_property_map(protected_edges)));
-#else
-        bool beautify_flag = PMP::remove_degenerate_faces(
-            faces(_tm), _tm,
-            CGAL::parameters::edge_is_constrained_map(
-                CGAL::make_boolean_property_map(protected_edges)));
-#endif
+        bool beautify_flag = clean_degenerate_faces(_tm, protected_edges);
         if (!beautify_flag) {
-          std::cerr << "Removing degenerate faces failed." << std::endl;
-        }
-        if (verbose) {
-          std::cout << "Removing degenerate faces done." << std::endl;
+          LOOPCGAL_WARNING("Removing degenerate faces failed.");
         }
+        LOOPCGAL_DEBUG("Removing degenerate faces done.");
       }
     }
-  } else {
-    if (verbose)
-    {
-      std::cout << "Meshes do not intersect. Returning tm." << std::endl;
-    }
-  }
-  if (verbose) {
-    std::cout << "Clipping done." << std::endl;
+  } else if (!region_clipped) {
+    LOOPCGAL_DEBUG("Meshes do not intersect. Returning tm.");
   }
+  LOOPCGAL_DEBUG("Clipping done.");
 
   // store the result in a numpymesh object for sending back to Python
 
+  memory.phase("export");
+  LoopCGAL::checkpoint("export");
+  _tm.collect_garbage(); // compact freed slots before the export walk
+  release.reset();
   NumpyMesh result =
-      export_mesh(_tm, area_threshold, duplicate_vertex_threshold);
-  if (verbose) {
-    std::cout << "Exported clipped mesh with " << result.vertices.shape(0)
-              << " vertices and " << result.triangles.shape(0) << " triangles."
-              << std::endl;
-  }
+      export_mesh(std::move(_tm), area_threshold, duplicate_vertex_threshold,
+                  &attributes);
+  LOOPCGAL_DEBUG("Exported clipped mesh with "
+                 << result.vertices.shape(0) << " vertices and "
+                 << mesh_triangle_count(result) << " triangles.");
   return result;
 }
 
+// Isotropic remeshing with a fixed constraint set. Without a convergence
+// tolerance or a cancel token this is a single multi-iteration CGAL call.
+static int remesh_constrained(TriangleMesh &tm,
+                              std::set<TriangleMesh::Edge_index> &constrained,
+                              std::set<TriangleMesh::Vertex_index> &fixed,
+                              double target_edge_length,
+                              int number_of_iterations, bool relax_constraints,
+                              bool protect_constraints,
+                              double convergence_tolerance) {
+  auto params =
+      CGAL::parameters::edge_is_constrained_map(
+          CGAL::make_boolean_property_map(constrained))
+          .vertex_is_constrained_map(CGAL::make_boolean_property_map(fixed))
+          .relax_constraints(relax_constraints)
+          .protect_constraints(protect_constraints);
+  const bool check_convergence = convergence_tolerance > 0.0;
+  if (!check_convergence && !LoopCGAL::current_cancel_token()) {
+    PMP::isotropic_remeshing(
+        faces(tm), target_edge_length, tm,
+        params.number_of_iterations(number_of_iterations));
+    return number_of_iterations;
+  }
+  RemeshStats stats;
+  if (check_convergence)
+    stats = remesh_stats(tm, target_edge_length);
+  int iter = 0;
+  while (iter < number_of_iterations) {
+    LoopCGAL::checkpoint("remesh", double(iter) / number_of_iterations);
+    PMP::isotropic_remeshing(faces(tm), target_edge_length, tm,
+                             params.number_of_iterations(1));
+    ++iter;
+    if (!check_convergence)
+      continue;
+    RemeshStats current = remesh_stats(tm, target_edge_length);
+    const bool converged =
+        remesh_converged(stats, current, convergence_tolerance);
+    stats = current;
+    if (converged)
+      break;
+  }
+  LOOPCGAL_DEBUG("Remeshing stopped after " << iter << " iteration(s).");
+  return iter;
+}
+
 std::vector<NumpyMesh>
 corefine_mesh(NumpyMesh tm1, NumpyMesh tm2, double target_edge_length,
               double duplicate_vertex_threshold, double area_threshold,
               int number_of_iterations, bool relax_constraints,
-              bool protect_constraints, bool verbose) {
+              bool protect_constraints, bool verbose,
+              double convergence_tolerance) {
+  LoopCGAL::ScopedLogLevel log_scope(verbose);
+  LoopCGAL::MemoryCall memory("corefine_mesh");
+  memory.phase("load");
   // Load the meshes
   TriangleMesh _tm1 = load_mesh(tm1, false);
   TriangleMesh _tm2 = load_mesh(tm2, false);
+  AttributeTransfer attributes1(tm1), attributes2(tm2);
+  // The CGAL phases run without the GIL; checkpoints take it back only
+  // for the progress callback and signals.
+  std::optional<pybind11::gil_scoped_release> release(std::in_place);
   PMP::split_long_edges(edges(_tm1), target_edge_length, _tm1);
   PMP::split_long_edges(edges(_tm2), target_edge_length, _tm2);
+  LoopCGAL::checkpoint("load", 1.0);
 
   // Perform corefinement
-  PMP::corefine(_tm1, _tm2);
+  memory.phase("corefine");
+  LoopCGAL::CancelVisitor<PMP::Corefinement::Default_visitor<TriangleMesh>>
+      visitor;
+  PMP::corefine(_tm1, _tm2, CGAL::parameters::visitor(visitor));
+  LoopCGAL::checkpoint("corefine", 1.0);
   // Find shared edges
   std::set<TriangleMesh::Edge_index> tm_1_shared_edges;
   std::set<TriangleMesh::Edge_index> tm_2_shared_edges;
   for (const auto &edge1 : _tm1.edges()) {
+    LoopCGAL::check_cancelled();
     Point p1 = _tm1.point(CGAL::source(edge1, _tm1));
     Point p2 = _tm1.point(CGAL::target(edge1, _tm1));
 
@@ -440,12 +674,10 @@ corefine_mesh(NumpyMesh tm1, NumpyMesh tm2, double target_edge_length,
       }
     }
   }
-  if (verbose)
-  {
-    std::cout << "Found " << tm_1_shared_edges.size()
-              << " shared edges in tm1 and " << tm_2_shared_edges.size()
-              << " shared edges in tm2." << std::endl;
-  }
+  LOOPCGAL_DEBUG("Found " << tm_1_shared_edges.size()
+                           << " shared edges in tm1 and "
+                           << tm_2_shared_edges.size()
+                           << " shared edges in tm2.");
   // std::set<TriangleMesh::Edge_index> constrained_edges;
 
   std::set<TriangleMesh::Edge_index> boundary_edges =
@@ -456,29 +688,27 @@ corefine_mesh(NumpyMesh tm1, NumpyMesh tm2, double target_edge_length,
   tm_1_shared_edges.insert(boundary_edges.begin(), boundary_edges.end());
   tm_2_shared_edges.insert(boundary_edges2.begin(), boundary_edges2.end());
   // Refine the meshes
+  memory.phase("remesh");
   // Perform isotropic remeshing on _tm
-  PMP::isotropic_remeshing(
-      faces(_tm1), // Range of faces to remesh
-      target_edge_length, _tm1,
-      CGAL::parameters::number_of_iterations(number_of_iterations)
-          .edge_is_constrained_map(
-              CGAL::make_boolean_property_map(tm_1_shared_edges))
-          .relax_constraints(relax_constraints)
-          .protect_constraints(protect_constraints));
-  PMP::isotropic_remeshing(
-      faces(_tm2), // Range of faces to remesh
-      target_edge_length, _tm2,
-      CGAL::parameters::number_of_iterations(number_of_iterations)
-          .edge_is_constrained_map(
-              CGAL::make_boolean_property_map(tm_2_shared_edges))
-          .relax_constraints(relax_constraints)
-          .protect_constraints(protect_constraints));
-
-  if (verbose)
-  {
-    std::cout << "Corefinement done." << std::endl;
-  }
+  std::set<TriangleMesh::Vertex_index> no_fixed_vertices;
+  remesh_constrained(_tm1, tm_1_shared_edges, no_fixed_vertices,
+                     target_edge_length, number_of_iterations,
+                     relax_constraints, protect_constraints,
+                     convergence_tolerance);
+  remesh_constrained(_tm2, tm_2_shared_edges, no_fixed_vertices,
+                     target_edge_length, number_of_iterations,
+                     relax_constraints, protect_constraints,
+                     convergence_tolerance);
+
+  LOOPCGAL_DEBUG("Corefinement done.");
+  memory.phase("export");
+  LoopCGAL::checkpoint("export");
+  _tm1.collect_garbage();
+  _tm2.collect_garbage();
+  release.reset();
   return {
-      export_mesh(_tm1, area_threshold, duplicate_vertex_threshold),
-      export_mesh(_tm2, area_threshold, duplicate_vertex_threshold)};
+      export_mesh(std::move(_tm1), area_threshold,
+                  duplicate_vertex_threshold, &attributes1),
+      export_mesh(std::move(_tm2), area_threshold,
+                  duplicate_vertex_threshold, &attributes2)};
 }
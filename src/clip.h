@@ -22,7 +22,9 @@ NumpyMesh clip_surface(NumpyMesh tm, NumpyMesh clipper,
                        double duplicate_vertex_threshold = 1e-6,
                        double area_threshold = 1e-6,
                        bool protect_constraints = true,
-                       bool relax_constraints = false, bool verbose = false);
+                       bool relax_constraints = false, bool verbose = false,
+                       double convergence_tolerance = 0.01,
+                       bool region_of_interest = false);
 NumpyMesh clip_plane(NumpyMesh tm, NumpyPlane clipper,
                      double target_edge_length = 10.0,
                      bool remesh_before_clipping = true,
@@ -31,18 +33,21 @@ NumpyMesh clip_plane(NumpyMesh tm, NumpyPlane clipper,
                      double duplicate_vertex_threshold = 1e-6,
                      double area_threshold = 1e-6,
                      bool protect_constraints = true,
-                     bool relax_constraints = false, bool verbose = false);
+                     bool relax_constraints = false, bool verbose = false,
+                     double convergence_tolerance = 0.01);
 TriangleMesh load_mesh(NumpyMesh mesh, bool verbose = false);
 Plane load_plane(NumpyPlane plane, bool verbose = false);
-void refine_mesh(TriangleMesh &mesh, bool split_long_edges = true,
-                 bool verbose = false, double target_edge_length = 10.0,
-                 int number_of_iterations = 1, bool protect_constraints = true,
-                 bool relax_constraints = false);
+bool plane_cuts_mesh(const TriangleMesh &mesh, const Plane &P);
+int refine_mesh(TriangleMesh &mesh, bool split_long_edges = true,
+                bool verbose = false, double target_edge_length = 10.0,
+                int number_of_iterations = 1, bool protect_constraints = true,
+                bool relax_constraints = false,
+                double convergence_tolerance = 0.01);
 
 std::vector<NumpyMesh>
 corefine_mesh(NumpyMesh tm1, NumpyMesh tm2, double target_edge_length = 10.0,
               double duplicate_vertex_threshold = 1e-6,
               double area_threshold = 1e-6, int number_of_iterations = 3,
               bool relax_constraints = true, bool protect_constraints = false,
-              bool verbose = false);
+              bool verbose = false, double convergence_tolerance = 0.01);
 #endif
\ No newline at end of file
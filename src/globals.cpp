@@ -1,13 +1,268 @@
 #include "globals.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
 #include <iostream>
+#include <thread>
 
 namespace LoopCGAL
 {
-    bool verbose = false; // Definition of the verbose flag
+    namespace
+    {
+        constexpr std::size_t kLogCapacity = 4096; // must be a power of two
+        constexpr std::size_t kLogMessageSize = 256;
+
+        // Bounded multi-producer/multi-consumer queue (Vyukov). Each slot
+        // carries a sequence number telling producers and consumers whose
+        // turn it is, so neither side ever takes a lock.
+        struct LogSlot
+        {
+            std::atomic<std::size_t> sequence;
+            LogLevel level;
+            std::size_t length;
+            char text[kLogMessageSize];
+        };
+
+        struct LogRing
+        {
+            LogRing()
+            {
+                for (std::size_t i = 0; i < kLogCapacity; ++i)
+                    slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+            std::array<LogSlot, kLogCapacity> slots;
+            alignas(64) std::atomic<std::size_t> head{0};
+            alignas(64) std::atomic<std::size_t> tail{0};
+            std::atomic<std::size_t> dropped{0};
+        };
+
+        LogRing &ring()
+        {
+            static LogRing instance;
+            return instance;
+        }
+
+        std::atomic<int> g_log_level{static_cast<int>(LogLevel::Warning)};
+        std::atomic<int> g_stderr_level{static_cast<int>(LogLevel::Warning)};
+        std::atomic<int> g_validation_level{
+            static_cast<int>(ValidationLevel::InputsOnly)};
+        std::atomic<int> g_index_type{static_cast<int>(IndexType::Int32)};
+        std::atomic<int> g_face_layout{static_cast<int>(FaceLayout::Rows)};
+        std::atomic<int> g_num_threads{0};
+        std::atomic<bool> g_spatial_ordering{false};
+        thread_local int t_call_level = -1; // -1: follow the module default
+        thread_local int t_index_type = -1;
+        thread_local int t_face_layout = -1;
+    } // namespace
+
+    void set_log_level(LogLevel level)
+    {
+        g_log_level.store(static_cast<int>(level), std::memory_order_relaxed);
+    }
+
+    LogLevel get_log_level()
+    {
+        return static_cast<LogLevel>(g_log_level.load(std::memory_order_relaxed));
+    }
+
+    void set_stderr_level(LogLevel level)
+    {
+        g_stderr_level.store(static_cast<int>(level),
+                             std::memory_order_relaxed);
+    }
+
+    LogLevel get_stderr_level()
+    {
+        return static_cast<LogLevel>(
+            g_stderr_level.load(std::memory_order_relaxed));
+    }
 
     void set_verbose(bool value)
     {
-        verbose = value;
-        std::cout << "Verbose flag set to: " << verbose << std::endl;
+        set_log_level(value ? LogLevel::Debug : LogLevel::Warning);
+    }
+
+    void set_validation_level(ValidationLevel level)
+    {
+        g_validation_level.store(static_cast<int>(level),
+                                 std::memory_order_relaxed);
+    }
+
+    ValidationLevel get_validation_level()
+    {
+        return static_cast<ValidationLevel>(
+            g_validation_level.load(std::memory_order_relaxed));
+    }
+
+    void set_index_type(IndexType type)
+    {
+        g_index_type.store(static_cast<int>(type), std::memory_order_relaxed);
+    }
+
+    IndexType get_index_type()
+    {
+        if (t_index_type >= 0)
+            return static_cast<IndexType>(t_index_type);
+        return static_cast<IndexType>(
+            g_index_type.load(std::memory_order_relaxed));
+    }
+
+    void set_face_layout(FaceLayout layout)
+    {
+        g_face_layout.store(static_cast<int>(layout), std::memory_order_relaxed);
+    }
+
+    FaceLayout get_face_layout()
+    {
+        if (t_face_layout >= 0)
+            return static_cast<FaceLayout>(t_face_layout);
+        return static_cast<FaceLayout>(
+            g_face_layout.load(std::memory_order_relaxed));
+    }
+
+    void set_spatial_ordering(bool value)
+    {
+        g_spatial_ordering.store(value, std::memory_order_relaxed);
+    }
+
+    bool get_spatial_ordering()
+    {
+        return g_spatial_ordering.load(std::memory_order_relaxed);
+    }
+
+    void set_num_threads(int n)
+    {
+        g_num_threads.store(std::max(n, 0), std::memory_order_relaxed);
+    }
+
+    std::size_t num_threads()
+    {
+        const int n = g_num_threads.load(std::memory_order_relaxed);
+        if (n > 0)
+            return static_cast<std::size_t>(n);
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    bool log_enabled(LogLevel level)
+    {
+        const int current =
+            std::max(t_call_level, g_log_level.load(std::memory_order_relaxed));
+        return static_cast<int>(level) <= current &&
+               level != LogLevel::Off;
+    }
+
+    void log_message(LogLevel level, const std::string &message)
+    {
+        if (level != LogLevel::Off &&
+            static_cast<int>(level) <=
+                g_stderr_level.load(std::memory_order_relaxed))
+            std::cerr << message << std::endl;
+        LogRing &r = ring();
+        std::size_t pos = r.head.load(std::memory_order_relaxed);
+        LogSlot *slot;
+        for (;;)
+        {
+            slot = &r.slots[pos & (kLogCapacity - 1)];
+            const std::size_t seq = slot->sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff =
+                static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0)
+            {
+                if (r.head.compare_exchange_weak(pos, pos + 1,
+                                                 std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                r.dropped.fetch_add(1, std::memory_order_relaxed);
+                return; // full: drop rather than block the caller
+            }
+            else
+            {
+                pos = r.head.load(std::memory_order_relaxed);
+            }
+        }
+        slot->level = level;
+        std::size_t length = std::min(message.size(), kLogMessageSize);
+        // Never cut a UTF-8 sequence in half when truncating
+        while (length < message.size() && length > 0 &&
+               (static_cast<unsigned char>(message[length]) & 0xC0) == 0x80)
+            --length;
+        slot->length = length;
+        std::memcpy(slot->text, message.data(), slot->length);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+    }
+
+    std::vector<LogRecord> drain_log()
+    {
+        LogRing &r = ring();
+        std::vector<LogRecord> records;
+        std::size_t pos = r.tail.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            LogSlot *slot = &r.slots[pos & (kLogCapacity - 1)];
+            const std::size_t seq = slot->sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) -
+                                        static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0)
+            {
+                if (r.tail.compare_exchange_weak(pos, pos + 1,
+                                                 std::memory_order_relaxed))
+                {
+                    records.push_back(
+                        {slot->level, std::string(slot->text, slot->length)});
+                    slot->sequence.store(pos + kLogCapacity,
+                                         std::memory_order_release);
+                    pos = r.tail.load(std::memory_order_relaxed);
+                }
+            }
+            else if (diff < 0)
+            {
+                return records; // empty
+            }
+            else
+            {
+                pos = r.tail.load(std::memory_order_relaxed);
+            }
+        }
     }
-}
\ No newline at end of file
+
+    std::size_t dropped_log_records()
+    {
+        return ring().dropped.load(std::memory_order_relaxed);
+    }
+
+    ScopedLogLevel::ScopedLogLevel(bool verbose) : _previous(t_call_level)
+    {
+        if (verbose)
+            t_call_level = static_cast<int>(LogLevel::Debug);
+    }
+
+    ScopedLogLevel::~ScopedLogLevel() { t_call_level = _previous; }
+
+    int call_log_level() { return t_call_level; }
+
+    ScopedExportFormat::ScopedExportFormat(int index_type, int face_layout)
+        : _previous_index_type(t_index_type),
+          _previous_face_layout(t_face_layout)
+    {
+        if (index_type >= 0)
+            t_index_type = index_type;
+        if (face_layout >= 0)
+            t_face_layout = face_layout;
+    }
+
+    ScopedExportFormat::~ScopedExportFormat()
+    {
+        t_index_type = _previous_index_type;
+        t_face_layout = _previous_face_layout;
+    }
+
+    ScopedCallLogLevel::ScopedCallLogLevel(int level) : _previous(t_call_level)
+    {
+        t_call_level = level;
+    }
+
+    ScopedCallLogLevel::~ScopedCallLogLevel() { t_call_level = _previous; }
+}
@@ -1,10 +1,159 @@
 #ifndef GLOBALS_H
 #define GLOBALS_H
 
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <vector>
+
 namespace LoopCGAL
 {
-    extern bool verbose; // Declaration of the module-wide verbose flag
-    void set_verbose(bool value); // Declaration of the set_verbose function
+    enum class LogLevel : int
+    {
+        Off = 0,
+        Error = 1,
+        Warning = 2,
+        Info = 3,
+        Debug = 4
+    };
+
+    struct LogRecord
+    {
+        LogLevel level;
+        std::string message;
+    };
+
+    // Module-wide default level; calls may raise it for their own thread
+    // with ScopedLogLevel.
+    void set_log_level(LogLevel level);
+    LogLevel get_log_level();
+    void set_verbose(bool value); // Debug when true, Warning otherwise
+
+    // Cheap check used by the logging macros before formatting anything
+    bool log_enabled(LogLevel level);
+
+    // Push a record into the lock-free ring buffer. Never blocks; records
+    // are dropped (and counted) when the buffer is full.
+    void log_message(LogLevel level, const std::string &message);
+    // Records at or above this level are also written to std::cerr, so
+    // callers that never drain the buffer still see them. Warning by
+    // default; Off leaves the buffer as the only sink.
+    void set_stderr_level(LogLevel level);
+    LogLevel get_stderr_level();
+    std::vector<LogRecord> drain_log();
+    std::size_t dropped_log_records();
+
+    // How often full CGAL::is_valid_polygon_mesh traversals are run:
+    // never, once on each input mesh, or after every modifying step.
+    enum class ValidationLevel : int
+    {
+        Off = 0,
+        InputsOnly = 1,
+        Paranoid = 2
+    };
+    void set_validation_level(ValidationLevel level);
+    ValidationLevel get_validation_level();
+
+    // Integer type of the exported triangle arrays. Int64 matches the
+    // vtkIdType face arrays of pyvista, so they need no conversion there.
+    // The setters change the module-wide default; a call can override it
+    // for its own thread with ScopedExportFormat, so concurrent callers
+    // that want different formats do not race on the default.
+    enum class IndexType : int
+    {
+        Int32 = 0,
+        Int64 = 1
+    };
+    void set_index_type(IndexType type);
+    IndexType get_index_type();
+
+    // Layout of the exported triangles: (n, 3) rows, the legacy padded VTK
+    // cell array, or VTK offsets + connectivity.
+    enum class FaceLayout : int
+    {
+        Rows = 0,
+        Padded = 1,
+        Offsets = 2
+    };
+    void set_face_layout(FaceLayout layout);
+    FaceLayout get_face_layout();
+
+    // Hilbert-order the vertices and faces of meshes loaded by the clip /
+    // corefine / query entry points, and of every exported mesh, so that
+    // tree traversals, remeshing walks and the exported arrays touch memory
+    // sequentially. Off by default: vertex ids then follow the input rows.
+    void set_spatial_ordering(bool value);
+    bool get_spatial_ordering();
+
+    // Worker threads used by the batched queries; 0 (the default) means
+    // std::thread::hardware_concurrency().
+    void set_num_threads(int n);
+    std::size_t num_threads();
+
+    // Per-call export format on the calling thread; -1 keeps the module
+    // default for that field.
+    class ScopedExportFormat
+    {
+    public:
+        ScopedExportFormat(int index_type, int face_layout);
+        ScopedExportFormat(const ScopedExportFormat &) = delete;
+        ScopedExportFormat &operator=(const ScopedExportFormat &) = delete;
+        ~ScopedExportFormat();
+
+    private:
+        int _previous_index_type;
+        int _previous_face_layout;
+    };
+
+    // Per-call override: a call made with verbose = true logs at Debug on
+    // the calling thread until the scope ends.
+    class ScopedLogLevel
+    {
+    public:
+        explicit ScopedLogLevel(bool verbose);
+        ScopedLogLevel(const ScopedLogLevel &) = delete;
+        ScopedLogLevel &operator=(const ScopedLogLevel &) = delete;
+        ~ScopedLogLevel();
+
+    private:
+        int _previous;
+    };
+
+    // The calling thread's per-call level (-1 when it follows the module
+    // default), handed on to worker threads by parallel_for.
+    int call_log_level();
+    class ScopedCallLogLevel
+    {
+    public:
+        explicit ScopedCallLogLevel(int level);
+        ScopedCallLogLevel(const ScopedCallLogLevel &) = delete;
+        ScopedCallLogLevel &operator=(const ScopedCallLogLevel &) = delete;
+        ~ScopedCallLogLevel();
+
+    private:
+        int _previous;
+    };
 }
 
-#endif // GLOBALS_H
\ No newline at end of file
+#define LOOPCGAL_LOG(level, stream_expr)                        \
+    do                                                          \
+    {                                                           \
+        if (::LoopCGAL::log_enabled(level))                     \
+        {                                                       \
+            std::ostringstream loopcgal_log_stream;             \
+            loopcgal_log_stream << stream_expr;                 \
+            ::LoopCGAL::log_message(level,                      \
+                                    loopcgal_log_stream.str()); \
+        }                                                       \
+    } while (0)
+
+#define LOOPCGAL_ERROR(stream_expr) \
+    LOOPCGAL_LOG(::LoopCGAL::LogLevel::Error, stream_expr)
+#define LOOPCGAL_WARNING(stream_expr) \
+    LOOPCGAL_LOG(::LoopCGAL::LogLevel::Warning, stream_expr)
+#define LOOPCGAL_INFO(stream_expr) \
+    LOOPCGAL_LOG(::LoopCGAL::LogLevel::Info, stream_expr)
+#define LOOPCGAL_DEBUG(stream_expr) \
+    LOOPCGAL_LOG(::LoopCGAL::LogLevel::Debug, stream_expr)
+
+#endif // GLOBALS_H
@@ -0,0 +1,76 @@
+#include "intersection.h"
+#include "clip.h"
+#include "globals.h"
+#include "meshstate.h"
+#include "meshutils.h"
+#include "parallel.h"
+#include <CGAL/Polygon_mesh_processing/bbox.h>
+#include <CGAL/Polygon_mesh_processing/intersection.h>
+#include <pybind11/pybind11.h>
+#include <exception>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+namespace PMP = CGAL::Polygon_mesh_processing;
+
+NumpyPolylines intersection_curves(NumpyMesh tm1, NumpyMesh tm2, bool verbose)
+{
+  return intersection_curves_batch({tm1, tm2}, {{0, 1}}, verbose);
+}
+
+NumpyPolylines
+intersection_curves_batch(std::vector<NumpyMesh> meshes,
+                          std::vector<std::pair<int, int>> pairs,
+                          bool verbose)
+{
+  LoopCGAL::ScopedLogLevel log_scope(verbose);
+  const int n_meshes = static_cast<int>(meshes.size());
+  for (const auto &pair : pairs)
+    if (pair.first < 0 || pair.first >= n_meshes || pair.second < 0 ||
+        pair.second >= n_meshes)
+      throw std::invalid_argument("Mesh pair index out of range.");
+
+  std::vector<TriangleMesh> loaded;
+  std::vector<CGAL::Bbox_3> boxes;
+  loaded.reserve(meshes.size());
+  boxes.reserve(meshes.size());
+  for (std::size_t i = 0; i < meshes.size(); ++i)
+  {
+    loaded.push_back(load_mesh(meshes[i], verbose));
+    MeshState state;
+    validate_mesh(loaded.back(), state, ValidationStage::Input,
+                  ("mesh " + std::to_string(i)).c_str());
+    boxes.push_back(PMP::bbox(loaded.back()));
+  }
+
+  std::vector<Polylines> curves(pairs.size());
+  {
+    pybind11::gil_scoped_release release;
+    LoopCGAL::parallel_for(pairs.size(), [&](std::size_t i) {
+      const TriangleMesh &a = loaded[pairs[i].first];
+      const TriangleMesh &b = loaded[pairs[i].second];
+      if (pairs[i].first == pairs[i].second ||
+          !CGAL::do_overlap(boxes[pairs[i].first], boxes[pairs[i].second]))
+        return;
+      // surface_intersection only reads its inputs (Surface_mesh has
+      // native vertex/face indices, so no dynamic property map is added),
+      // which lets concurrent pairs share the loaded meshes.
+      try
+      {
+        PMP::surface_intersection(
+            a, b, std::back_inserter(curves[i]),
+            CGAL::parameters::throw_on_self_intersection(true));
+      }
+      catch (const std::exception &e)
+      {
+        curves[i].clear();
+        LOOPCGAL_WARNING("No intersection curves for pair ("
+                         << pairs[i].first << ", " << pairs[i].second
+                         << "): " << e.what());
+      }
+    });
+  }
+  LOOPCGAL_DEBUG("Intersected " << pairs.size() << " mesh pairs.");
+  return export_polylines(curves);
+}
@@ -0,0 +1,19 @@
+#ifndef INTERSECTION_H
+#define INTERSECTION_H
+#include "numpymesh.h"
+#include <utility>
+#include <vector>
+
+// Contact curves between surfaces, from PMP::surface_intersection only:
+// no corefinement, remeshing or mesh export. The batched form loads every
+// mesh once and runs the pairs (indices into meshes) in parallel with the
+// GIL released; polyline ids are indices into pairs. A pair that fails
+// (e.g. on a self-intersecting mesh) is logged and yields no curves.
+NumpyPolylines intersection_curves(NumpyMesh tm1, NumpyMesh tm2,
+                                   bool verbose = false);
+NumpyPolylines
+intersection_curves_batch(std::vector<NumpyMesh> meshes,
+                          std::vector<std::pair<int, int>> pairs,
+                          bool verbose = false);
+
+#endif // INTERSECTION_H
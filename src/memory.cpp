@@ -0,0 +1,333 @@
+#include "memory.h"
+#include "globals.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <deque>
+#include <iomanip>
+#include <mutex>
+#include <new>
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+
+namespace
+{
+    std::atomic<std::int64_t> g_live{0};
+    std::atomic<std::int64_t> g_peak{0};
+
+    void note_allocated(std::int64_t bytes)
+    {
+        const std::int64_t live =
+            g_live.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        std::int64_t peak = g_peak.load(std::memory_order_relaxed);
+        while (live > peak &&
+               !g_peak.compare_exchange_weak(peak, live,
+                                             std::memory_order_relaxed))
+        {
+        }
+    }
+
+    void note_released(std::int64_t bytes)
+    {
+        g_live.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+#ifdef LOOPCGAL_MEMORY_ACCOUNTING
+    // Usable size of a block, which is what the allocator really holds
+    std::size_t block_size(void *p, std::size_t alignment)
+    {
+#if defined(_WIN32)
+        return alignment ? _aligned_msize(p, alignment, 0) : _msize(p);
+#elif defined(__APPLE__)
+        (void)alignment;
+        return malloc_size(p);
+#else
+        (void)alignment;
+        return malloc_usable_size(p);
+#endif
+    }
+
+    // alignment 0 selects plain malloc
+    void *allocate(std::size_t size, std::size_t alignment)
+    {
+        if (size == 0)
+            size = 1;
+        for (;;)
+        {
+            void *p = nullptr;
+#if defined(_WIN32)
+            p = alignment ? _aligned_malloc(size, alignment)
+                          : std::malloc(size);
+#else
+            if (alignment == 0)
+                p = std::malloc(size);
+            else if (posix_memalign(&p, std::max(alignment, sizeof(void *)),
+                                    size) != 0)
+                p = nullptr;
+#endif
+            if (p)
+            {
+                note_allocated(
+                    static_cast<std::int64_t>(block_size(p, alignment)));
+                return p;
+            }
+            std::new_handler handler = std::get_new_handler();
+            if (!handler)
+                return nullptr;
+            handler();
+        }
+    }
+
+    void release(void *p, std::size_t alignment)
+    {
+        if (!p)
+            return;
+        note_released(static_cast<std::int64_t>(block_size(p, alignment)));
+#if defined(_WIN32)
+        if (alignment)
+            _aligned_free(p);
+        else
+            std::free(p);
+#else
+        std::free(p);
+#endif
+    }
+
+    void *allocate_or_throw(std::size_t size, std::size_t alignment)
+    {
+        if (void *p = allocate(size, alignment))
+            return p;
+        throw std::bad_alloc();
+    }
+
+    void *allocate_nothrow(std::size_t size, std::size_t alignment) noexcept
+    {
+        try
+        {
+            return allocate(size, alignment);
+        }
+        catch (...)
+        {
+            return nullptr;
+        }
+    }
+#endif // LOOPCGAL_MEMORY_ACCOUNTING
+} // namespace
+
+#ifdef LOOPCGAL_MEMORY_ACCOUNTING
+// Replacements for the whole module. The version script makes these local
+// symbols; the rest of the process keeps its own allocator.
+void *operator new(std::size_t size) { return allocate_or_throw(size, 0); }
+void *operator new[](std::size_t size) { return allocate_or_throw(size, 0); }
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    return allocate_nothrow(size, 0);
+}
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    return allocate_nothrow(size, 0);
+}
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    return allocate_or_throw(size, static_cast<std::size_t>(alignment));
+}
+void *operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return allocate_or_throw(size, static_cast<std::size_t>(alignment));
+}
+void *operator new(std::size_t size, std::align_val_t alignment,
+                   const std::nothrow_t &) noexcept
+{
+    return allocate_nothrow(size, static_cast<std::size_t>(alignment));
+}
+void *operator new[](std::size_t size, std::align_val_t alignment,
+                     const std::nothrow_t &) noexcept
+{
+    return allocate_nothrow(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *p) noexcept { release(p, 0); }
+void operator delete[](void *p) noexcept { release(p, 0); }
+void operator delete(void *p, std::size_t) noexcept { release(p, 0); }
+void operator delete[](void *p, std::size_t) noexcept { release(p, 0); }
+void operator delete(void *p, const std::nothrow_t &) noexcept
+{
+    release(p, 0);
+}
+void operator delete[](void *p, const std::nothrow_t &) noexcept
+{
+    release(p, 0);
+}
+void operator delete(void *p, std::align_val_t alignment) noexcept
+{
+    release(p, static_cast<std::size_t>(alignment));
+}
+void operator delete[](void *p, std::align_val_t alignment) noexcept
+{
+    release(p, static_cast<std::size_t>(alignment));
+}
+void operator delete(void *p, std::size_t, std::align_val_t alignment) noexcept
+{
+    release(p, static_cast<std::size_t>(alignment));
+}
+void operator delete[](void *p, std::size_t,
+                       std::align_val_t alignment) noexcept
+{
+    release(p, static_cast<std::size_t>(alignment));
+}
+void operator delete(void *p, std::align_val_t alignment,
+                     const std::nothrow_t &) noexcept
+{
+    release(p, static_cast<std::size_t>(alignment));
+}
+void operator delete[](void *p, std::align_val_t alignment,
+                       const std::nothrow_t &) noexcept
+{
+    release(p, static_cast<std::size_t>(alignment));
+}
+#endif // LOOPCGAL_MEMORY_ACCOUNTING
+
+namespace LoopCGAL
+{
+    namespace
+    {
+        constexpr std::size_t kMaxReports = 64;
+
+        thread_local MemoryCall *t_call = nullptr;
+
+        std::mutex &reports_mutex()
+        {
+            static std::mutex instance;
+            return instance;
+        }
+
+        std::deque<MemoryReport> &reports()
+        {
+            static std::deque<MemoryReport> instance;
+            return instance;
+        }
+
+        std::string mib(std::int64_t bytes)
+        {
+            std::ostringstream out;
+            out << std::fixed << std::setprecision(1)
+                << static_cast<double>(bytes) / (1024.0 * 1024.0);
+            return out.str();
+        }
+    } // namespace
+
+    bool memory_accounting_enabled()
+    {
+#ifdef LOOPCGAL_MEMORY_ACCOUNTING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // Blocks freed here but allocated by another module can push the
+    // counter below zero; clamp rather than report nonsense.
+    std::int64_t memory_live()
+    {
+        return std::max<std::int64_t>(
+            g_live.load(std::memory_order_relaxed), 0);
+    }
+
+    std::int64_t memory_peak()
+    {
+        return std::max<std::int64_t>(
+            g_peak.load(std::memory_order_relaxed), 0);
+    }
+
+    void reset_memory_peak()
+    {
+        g_peak.store(g_live.load(std::memory_order_relaxed),
+                     std::memory_order_relaxed);
+    }
+
+    std::vector<MemoryReport> drain_memory_reports()
+    {
+        std::lock_guard<std::mutex> lock(reports_mutex());
+        std::vector<MemoryReport> result(
+            std::make_move_iterator(reports().begin()),
+            std::make_move_iterator(reports().end()));
+        reports().clear();
+        return result;
+    }
+
+    MemoryCall::MemoryCall(const char *call) : _previous(t_call)
+    {
+        fold_peaks();
+        t_call = this;
+        _report.call = call;
+        _report.start = memory_live();
+        _report.peak = _report.start;
+        reset_memory_peak();
+    }
+
+    MemoryCall::~MemoryCall()
+    {
+        close_phase();
+        fold_peaks();
+        _report.end = memory_live();
+        t_call = _previous;
+        try
+        {
+            if (log_enabled(LogLevel::Info))
+            {
+                std::ostringstream line;
+                line << _report.call << " memory (MiB): start "
+                     << mib(_report.start) << ", peak " << mib(_report.peak)
+                     << ", end " << mib(_report.end);
+                for (const MemoryPhaseStats &phase : _report.phases)
+                    line << "; " << phase.name << " peak " << mib(phase.peak);
+                log_message(LogLevel::Info, line.str());
+            }
+            std::lock_guard<std::mutex> lock(reports_mutex());
+            if (reports().size() == kMaxReports)
+                reports().pop_front();
+            reports().push_back(std::move(_report));
+        }
+        catch (...)
+        {
+            // Never let accounting turn an unwinding call into a terminate
+        }
+    }
+
+    void MemoryCall::phase(const char *name)
+    {
+        close_phase();
+        fold_peaks();
+        MemoryPhaseStats stats;
+        stats.name = name;
+        stats.start = memory_live();
+        stats.peak = stats.start;
+        _report.phases.push_back(std::move(stats));
+        _in_phase = true;
+        reset_memory_peak();
+    }
+
+    void MemoryCall::close_phase()
+    {
+        if (!_in_phase)
+            return;
+        fold_peaks();
+        _report.phases.back().end = memory_live();
+        _in_phase = false;
+    }
+
+    void MemoryCall::fold_peaks()
+    {
+        const std::int64_t peak = memory_peak();
+        for (MemoryCall *call = t_call; call; call = call->_previous)
+        {
+            call->_report.peak = std::max(call->_report.peak, peak);
+            if (call->_in_phase)
+                call->_report.phases.back().peak =
+                    std::max(call->_report.phases.back().peak, peak);
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef MEMORY_H
+#define MEMORY_H
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace LoopCGAL
+{
+    // Heap accounting of this module. With LOOPCGAL_MEMORY_ACCOUNTING (off
+    // by default: it costs a malloc_usable_size call and an atomic update
+    // per allocation) the module replaces the global operator new / delete
+    // and counts the usable size of every block, so Surface_mesh
+    // properties, AABB trees and std::vector intermediates are all
+    // included. numpy arrays are not: they are allocated by numpy. On Linux
+    // src/loop_cgal.map keeps the operators out of the dynamic symbol
+    // table, so only the module's own code uses them. The counters are
+    // shared by all threads, so figures of concurrent calls overlap.
+    bool memory_accounting_enabled();
+    std::int64_t memory_live();  // bytes currently held
+    std::int64_t memory_peak();  // most bytes held since the last reset
+    void reset_memory_peak();    // restart the peak from the live bytes
+
+    struct MemoryPhaseStats
+    {
+        std::string name;
+        std::int64_t start = 0; // live bytes when the phase began
+        std::int64_t end = 0;   // live bytes when it ended
+        std::int64_t peak = 0;  // most live bytes in between
+    };
+
+    struct MemoryReport
+    {
+        std::string call;
+        std::int64_t start = 0;
+        std::int64_t end = 0;
+        std::int64_t peak = 0;
+        std::vector<MemoryPhaseStats> phases;
+    };
+
+    // Reports of the most recent calls, oldest first; at most 64 are kept.
+    std::vector<MemoryReport> drain_memory_reports();
+
+    // Per-call accounting. phase() ends the current phase and starts the
+    // next one; the report is logged at INFO level and stored when the
+    // scope ends, also when it is left by an exception. Calls may nest:
+    // an inner call's peaks are folded into the enclosing phase.
+    class MemoryCall
+    {
+    public:
+        explicit MemoryCall(const char *call);
+        MemoryCall(const MemoryCall &) = delete;
+        MemoryCall &operator=(const MemoryCall &) = delete;
+        ~MemoryCall();
+
+        void phase(const char *name);
+
+    private:
+        // Records the peak since the last reset in every open call of
+        // this thread; done before each reset so no maximum is lost.
+        static void fold_peaks();
+        void close_phase();
+
+        MemoryReport _report;
+        bool _in_phase = false;
+        MemoryCall *_previous;
+    };
+}
+
+#endif // MEMORY_H
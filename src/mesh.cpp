@@ -1,6 +1,11 @@
 #include "mesh.h"
+#include "clip.h"
 #include "meshutils.h"
+#include "arrayview.h"
+#include "cancel.h"
 #include "globals.h"
+#include "memory.h"
+#include "parallel.h"
 #include <CGAL/Polygon_mesh_processing/bbox.h>
 #include <CGAL/Polygon_mesh_processing/clip.h>
 #include <CGAL/Polygon_mesh_processing/corefinement.h>
@@ -14,18 +19,190 @@
 #include <CGAL/version.h>
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
 namespace PMP = CGAL::Polygon_mesh_processing;
 
+namespace
+{
+  // Points per work item of the parallel point queries
+  constexpr ssize_t kQueryChunk = 4096;
+
+  // Unnormalised, so degenerate faces give a zero vector instead of NaNs
+  Vector face_normal(const TriangleMesh &tm, TriangleMesh::Face_index f)
+  {
+    auto h = tm.halfedge(f);
+    return CGAL::normal(tm.point(tm.source(h)), tm.point(tm.target(h)),
+                        tm.point(tm.target(tm.next(h))));
+  }
+
+  Vector unit(const Vector &v)
+  {
+    const double length = std::sqrt(v.squared_length());
+    return length > 0 ? v / length : v;
+  }
+
+  // Angle-weighted pseudo-normal of v (Baerentzen & Aanaes): incident face
+  // normals weighted by their corner angle at v.
+  Vector vertex_pseudo_normal(const TriangleMesh &tm,
+                              TriangleMesh::Vertex_index v)
+  {
+    Vector n(0, 0, 0);
+    for (auto h : CGAL::halfedges_around_target(tm.halfedge(v), tm))
+    {
+      if (tm.is_border(h))
+        continue;
+      const Vector e1 = tm.point(tm.source(h)) - tm.point(v);
+      const Vector e2 = tm.point(tm.target(tm.next(h))) - tm.point(v);
+      const double angle = std::atan2(
+          std::sqrt(CGAL::cross_product(e1, e2).squared_length()), e1 * e2);
+      n = n + angle * unit(face_normal(tm, tm.face(h)));
+    }
+    return n;
+  }
+
+  // Pseudo-normal of the edge of h: the sum of its face normals
+  Vector edge_pseudo_normal(const TriangleMesh &tm,
+                            TriangleMesh::Halfedge_index h)
+  {
+    Vector n = unit(face_normal(tm, tm.face(h)));
+    const auto opposite = tm.opposite(h);
+    if (!tm.is_border(opposite))
+      n = n + unit(face_normal(tm, tm.face(opposite)));
+    return n;
+  }
+
+  // Normal that signs the offset p - q, for q the closest point to p on f.
+  // A face normal is only right for hits inside f; at an edge or a vertex
+  // the side is given by the pseudo-normal of that edge or vertex.
+  Vector closest_normal(const TriangleMesh &tm, TriangleMesh::Face_index f,
+                        const Point &q)
+  {
+    constexpr double kOnBoundary = 1e-7;
+    const auto h = tm.halfedge(f);
+    const Point &a = tm.point(tm.source(h));
+    const Point &b = tm.point(tm.target(h));
+    const Point &c = tm.point(tm.target(tm.next(h)));
+    const Vector ab = b - a, ac = c - a, aq = q - a;
+    const double d00 = ab * ab, d01 = ab * ac, d11 = ac * ac;
+    const double denom = d00 * d11 - d01 * d01;
+    if (!(denom > 0))
+      return face_normal(tm, f);
+    // Barycentric coordinates of q for a, b and c
+    const double wb = (d11 * (aq * ab) - d01 * (aq * ac)) / denom;
+    const double wc = (d00 * (aq * ac) - d01 * (aq * ab)) / denom;
+    const double wa = 1.0 - wb - wc;
+    if (wb < kOnBoundary && wc < kOnBoundary)
+      return vertex_pseudo_normal(tm, tm.source(h));
+    if (wa < kOnBoundary && wc < kOnBoundary)
+      return vertex_pseudo_normal(tm, tm.target(h));
+    if (wa < kOnBoundary && wb < kOnBoundary)
+      return vertex_pseudo_normal(tm, tm.target(tm.next(h)));
+    if (wa < kOnBoundary)
+      return edge_pseudo_normal(tm, tm.next(h));
+    if (wb < kOnBoundary)
+      return edge_pseudo_normal(tm, tm.prev(h));
+    if (wc < kOnBoundary)
+      return edge_pseudo_normal(tm, h);
+    return face_normal(tm, f);
+  }
+
+  // The fixed edges of tm as segments, taken before a clip
+  std::vector<Segment> fixed_segments(const TriangleMesh &tm,
+                                      EdgeFlagMap fixed)
+  {
+    std::vector<Segment> segments;
+    for (auto e : tm.edges())
+      if (fixed[e])
+        segments.emplace_back(tm.point(tm.vertex(e, 0)),
+                              tm.point(tm.vertex(e, 1)));
+    return segments;
+  }
+
+  // PMP::clip marks the intersection edges in the constraint map along with
+  // the pieces of the constrained edges it splits. Clears the flag of every
+  // edge that does not lie on one of segments, i.e. of the clip line.
+  void keep_fixed_pieces(TriangleMesh &tm, EdgeFlagMap fixed,
+                         const std::vector<Segment> &segments,
+                         const CGAL::Bbox_3 &box)
+  {
+    if (segments.empty())
+    {
+      for (auto e : tm.edges())
+        fixed[e] = false;
+      return;
+    }
+    SegmentTree tree(segments.begin(), segments.end());
+    tree.accelerate_distance_queries();
+    // Split points are rounded from exact constructions
+    const double tolerance =
+        1e-9 * std::sqrt(CGAL::square(box.xmax() - box.xmin()) +
+                         CGAL::square(box.ymax() - box.ymin()) +
+                         CGAL::square(box.zmax() - box.zmin()));
+    const double tolerance2 = tolerance * tolerance;
+    for (auto e : tm.edges())
+    {
+      if (!fixed[e])
+        continue;
+      const Point &p = tm.point(tm.vertex(e, 0));
+      const Point &q = tm.point(tm.vertex(e, 1));
+      const Segment &s = *tree.closest_point_and_primitive(
+                              CGAL::midpoint(p, q))
+                              .second;
+      fixed[e] = CGAL::squared_distance(s, p) <= tolerance2 &&
+                 CGAL::squared_distance(s, q) <= tolerance2;
+    }
+  }
+
+  // Releases the GIL, then locks the mutexes of the meshes a method works on
+  // until the end of the scope. Waiting for a mesh with the GIL held could
+  // block its holder at a checkpoint, which takes the GIL back.
+  template <typename... Mutexes>
+  class ReleasedLock
+  {
+  public:
+    explicit ReleasedLock(Mutexes &...mutexes) : _lock(mutexes...) {}
+
+  private:
+    pybind11::gil_scoped_release _release; // first released, last retaken
+    std::scoped_lock<Mutexes...> _lock;
+  };
+
+  // Calls make_query() with the GIL released and mesh_mutex held, then the
+  // query(i, p) it returns for every row of points, chunked over the worker
+  // threads.
+  template <typename MakeQuery>
+  void for_each_point(const pybind11::array &points,
+                      std::recursive_mutex &mesh_mutex,
+                      MakeQuery &&make_query)
+  {
+    LoopCGAL::visit_coordinates(points, [&](auto pts) {
+      ReleasedLock lock(mesh_mutex);
+      const auto query = make_query();
+      const ssize_t n = pts.shape(0);
+      const std::size_t n_chunks =
+          static_cast<std::size_t>((n + kQueryChunk - 1) / kQueryChunk);
+      LoopCGAL::parallel_for(n_chunks, [&](std::size_t c) {
+        const ssize_t begin = static_cast<ssize_t>(c) * kQueryChunk;
+        const ssize_t end = std::min(n, begin + kQueryChunk);
+        for (ssize_t i = begin; i < end; ++i)
+          query(i, Point(pts(i, 0), pts(i, 1), pts(i, 2)));
+      });
+    });
+  }
+} // namespace
+
 TriMesh::TriMesh(const std::vector<std::vector<int>> &triangles,
                  const std::vector<std::pair<double, double>> &vertices)
 {
 
   std::vector<TriangleMesh::Vertex_index> vertex_indices;
-  if (LoopCGAL::verbose)
-  {
-    std::cout << "Loading mesh with " << vertices.size() << " vertices and "
-              << triangles.size() << " triangles." << std::endl;
-  }
+  LOOPCGAL_DEBUG("Loading mesh with " << vertices.size() << " vertices and "
+                    << triangles.size() << " triangles.");
 
   // Assemble CGAL mesh objects from numpy/pybind11 arrays
   for (ssize_t i = 0; i < vertices.size(); ++i)
@@ -40,63 +217,83 @@ TriMesh::TriMesh(const std::vector<std::vector<int>> &triangles,
                    vertex_indices[triangles[i][2]]);
   }
 
-  if (LoopCGAL::verbose)
-  {
-    std::cout << "Loaded mesh with " << _mesh.number_of_vertices()
-              << " vertices and " << _mesh.number_of_faces() << " faces."
-              << std::endl;
-  }
+  LOOPCGAL_DEBUG("Loaded mesh with " << _mesh.number_of_vertices()
+                    << " vertices and " << _mesh.number_of_faces() << " faces.");
   init();
 }
 
-TriMesh::TriMesh(const pybind11::array_t<double> &vertices,
-                 const pybind11::array_t<int> &triangles)
+TriMesh::TriMesh(const pybind11::array &vertices,
+                 const pybind11::array &triangles,
+                 const pybind11::array &offsets)
 {
-  auto verts = vertices.unchecked<2>();
-  auto tris = triangles.unchecked<2>();
-  std::vector<TriangleMesh::Vertex_index> vertex_indices;
+  LoopCGAL::MemoryCall memory("TriMesh");
+  load_arrays(_mesh, vertices, triangles, offsets);
+  LOOPCGAL_DEBUG("Loaded mesh with " << _mesh.number_of_vertices()
+                    << " vertices and " << _mesh.number_of_faces() << " faces.");
 
-  for (ssize_t i = 0; i < verts.shape(0); ++i)
-  {
-    vertex_indices.push_back(
-        _mesh.add_vertex(Point(verts(i, 0), verts(i, 1), verts(i, 2))));
-  }
+  init();
+  LoopCGAL::checkpoint("load", 1.0);
+}
 
-  for (ssize_t i = 0; i < tris.shape(0); ++i)
-  {
-    _mesh.add_face(vertex_indices[tris(i, 0)], vertex_indices[tris(i, 1)],
-                   vertex_indices[tris(i, 2)]);
-  }
-  if (LoopCGAL::verbose)
-  {
-    std::cout << "Loaded mesh with " << _mesh.number_of_vertices()
-              << " vertices and " << _mesh.number_of_faces() << " faces."
-              << std::endl;
-  }
+TriMesh::TriMesh(const NumpyMesh &mesh)
+{
+  LoopCGAL::MemoryCall memory("TriMesh");
+  if (mesh.exported)
+    _mesh = mesh.exported->mesh();
+  else
+    load_arrays(_mesh, mesh.vertices, mesh.triangles, mesh.offsets);
+  LOOPCGAL_DEBUG("Loaded mesh with " << _mesh.number_of_vertices()
+                    << " vertices and " << _mesh.number_of_faces() << " faces.");
 
   init();
+  LoopCGAL::checkpoint("load", 1.0);
 }
 
 void TriMesh::init()
 {
-  _fixedEdges = collect_border_edges(_mesh);
+  // A mesh saved from another TriMesh brings its fixed edges along
+  _fixedEdges =
+      _mesh.add_property_map<TriangleMesh::Edge_index, bool>("e:fixed", false)
+          .first;
+  for (const auto &e : collect_border_edges(_mesh))
+    _fixedEdges[e] = true;
+
+  LOOPCGAL_DEBUG("Found " << countFixedEdges() << " fixed edges.");
+}
+
+std::size_t TriMesh::countFixedEdges() const
+{
+  std::size_t n = 0;
+  for (auto e : _mesh.edges())
+    n += _fixedEdges[e];
+  return n;
+}
 
+std::size_t TriMesh::fixedEdgeCount() const
+{
+  ReleasedLock lock(_mutex);
+  return countFixedEdges();
+}
 
-  if (LoopCGAL::verbose)
-  {
-    std::cout << "Found " << _fixedEdges.size() << " fixed edges." << std::endl;
-  }
-  _edge_is_constrained_map = CGAL::make_boolean_property_map(_fixedEdges);
+void TriMesh::setFixNewBorders(bool fix)
+{
+  ReleasedLock lock(_mutex);
+  _fix_new_borders = fix;
+}
+
+bool TriMesh::fixNewBorders() const
+{
+  ReleasedLock lock(_mutex);
+  return _fix_new_borders;
 }
 
 void TriMesh::add_fixed_edges(const pybind11::array_t<int> &pairs)
 {
-  if (!CGAL::is_valid_polygon_mesh(_mesh, LoopCGAL::verbose))
-  {
-    std::cerr << "Mesh is not valid!" << std::endl;
-  }
   // Convert std::set<std::array<int, 2>> to std::set<TriangleMesh::Edge_index>
   auto pairs_buf = pairs.unchecked<2>();
+  ReleasedLock lock(_mutex);
+  validate_mesh(_mesh, _state, ValidationStage::Input, "Mesh");
+  std::size_t n_invalid_vertices = 0, n_missing_edges = 0;
 
   for (ssize_t i = 0; i < pairs_buf.shape(0); ++i)
   {
@@ -104,8 +301,7 @@ void TriMesh::add_fixed_edges(const pybind11::array_t<int> &pairs)
     TriangleMesh::Vertex_index v1 = TriangleMesh::Vertex_index(pairs_buf(i, 0));
     if (!_mesh.is_valid(v0) || !_mesh.is_valid(v1))
     {
-      std::cerr << "Invalid vertex indices: (" << v0 << ", " << v1 << ")"
-                << std::endl;
+      ++n_invalid_vertices;
       continue; // Skip invalid vertex pairs
     }
     TriangleMesh::Halfedge_index edge =
@@ -113,34 +309,83 @@ void TriMesh::add_fixed_edges(const pybind11::array_t<int> &pairs)
                        TriangleMesh::Vertex_index(pairs_buf(i, 1)));
     if (edge == TriangleMesh::null_halfedge())
     {
-      std::cerr << "Half-edge is null for vertices (" << v1 << ", " << v0 << ")"
-                << std::endl;
+      ++n_missing_edges;
       continue;
     }
     if (!_mesh.is_valid(edge))  // Check if the halfedge is valid
     {
-      std::cerr << "Invalid half-edge for vertices (" << v0 << ", " << v1 << ")"
-                << std::endl;
+      ++n_missing_edges;
       continue; // Skip invalid edges
     }
-    TriangleMesh::Edge_index e = _mesh.edge(edge);
-
-    _fixedEdges.insert(e);
-    //     if (e.is_valid()) {
-    //         _fixedEdges.insert(e);
-    //     } else {
-    //         std::cerr << "Warning: Edge (" << edge[0] << ", " << edge[1] <<
-    //         ") is not valid in the mesh." << std::endl;
-    //     }
+    _fixedEdges[_mesh.edge(edge)] = true;
+  }
+  if (n_invalid_vertices + n_missing_edges > 0)
+  {
+    LOOPCGAL_WARNING("Skipped " << n_invalid_vertices
+                        << " pairs with invalid vertex indices and "
+                        << n_missing_edges
+                        << " pairs that are not mesh edges.");
+  }
+}
+const FaceTree &TriMesh::faceTree()
+{
+  if (_mesh.number_of_faces() == 0)
+    throw std::runtime_error("Mesh has no faces to query.");
+  if (!_tree || _tree_revision != _state.revision)
+  {
+    _tree.reset(new FaceTree(faces(_mesh).first, faces(_mesh).second, _mesh));
+    _tree->build();
+    _tree->accelerate_distance_queries();
+    _tree_revision = _state.revision;
+    LOOPCGAL_DEBUG("Built query tree over " << _mesh.number_of_faces()
+                                            << " faces.");
   }
-  // // Update the property map with the new fixed edges
-  _edge_is_constrained_map = CGAL::make_boolean_property_map(_fixedEdges);
+  return *_tree;
+}
+
+pybind11::array_t<double> TriMesh::signedDistance(const pybind11::array &points)
+{
+  LoopCGAL::check_rows(points, "points");
+  pybind11::array_t<double> result(points.shape(0));
+  double *out = result.mutable_data();
+  for_each_point(points, _mutex, [&]() {
+    const FaceTree *tree = &faceTree();
+    return [this, tree, out](ssize_t i, const Point &p) {
+      const auto hit = tree->closest_point_and_primitive(p);
+      const double d = std::sqrt(CGAL::squared_distance(p, hit.first));
+      const Vector n = closest_normal(_mesh, hit.second, hit.first);
+      out[i] = (p - hit.first) * n < 0 ? -d : d;
+    };
+  });
+  return result;
+}
+
+pybind11::array_t<double> TriMesh::closestPoint(const pybind11::array &points)
+{
+  LoopCGAL::check_rows(points, "points");
+  pybind11::array_t<double> result(
+      {points.shape(0), static_cast<ssize_t>(3)});
+  double *out = result.mutable_data();
+  for_each_point(points, _mutex, [&]() {
+    const FaceTree *tree = &faceTree();
+    return [tree, out](ssize_t i, const Point &p) {
+      const Point q = tree->closest_point(p);
+      out[3 * i] = q.x();
+      out[3 * i + 1] = q.y();
+      out[3 * i + 2] = q.z();
+    };
+  });
+  return result;
 }
-void TriMesh::remesh(bool split_long_edges,
-                     double target_edge_length, int number_of_iterations,
-                     bool protect_constraints, bool relax_constraints)
+
+int TriMesh::remesh(bool split_long_edges,
+                    double target_edge_length, int number_of_iterations,
+                    bool protect_constraints, bool relax_constraints,
+                    double convergence_tolerance)
 
 {
+  LoopCGAL::MemoryCall memory("TriMesh.remesh");
+  ReleasedLock lock(_mutex);
 
   // ------------------------------------------------------------------
   // 0.  Guard‑rail: sensible target length w.r.t. bbox
@@ -149,13 +394,13 @@ void TriMesh::remesh(bool split_long_edges,
   const double bbox_diag = std::sqrt(CGAL::square(bb.xmax() - bb.xmin()) +
                                      CGAL::square(bb.ymax() - bb.ymin()) +
                                      CGAL::square(bb.zmax() - bb.zmin()));
-  PMP::remove_isolated_vertices(_mesh);
+  if (PMP::remove_isolated_vertices(_mesh) > 0)
+    _state.touch();
   if (target_edge_length < 1e-4 * bbox_diag)
   {
-    if (LoopCGAL::verbose)
-      std::cout << "  ! target_edge_length (" << target_edge_length
-                << ") too small – skipping remesh\n";
-    return;
+    LOOPCGAL_DEBUG("  ! target_edge_length (" << target_edge_length
+                      << ") too small – skipping remesh");
+    return 0;
   }
 
   // ------------------------------------------------------------------
@@ -168,15 +413,9 @@ void TriMesh::remesh(bool split_long_edges,
     min_e = std::min(min_e, l);
     max_e = std::max(max_e, l);
   }
-  if (LoopCGAL::verbose)
-  {
-    std::cout << "      edge length range: [" << min_e << ", " << max_e
-              << "]  target = " << target_edge_length << '\n';
-  }
-  if (!CGAL::is_valid_polygon_mesh(_mesh, LoopCGAL::verbose) && LoopCGAL::verbose)
-  {
-    std::cout << "      ! mesh is not a valid polygon mesh\n";
-  }
+  LOOPCGAL_DEBUG("      edge length range: [" << min_e << ", " << max_e
+                    << "]  target = " << target_edge_length);
+  validate_mesh(_mesh, _state, ValidationStage::Intermediate, "mesh");
   // ------------------------------------------------------------------
   // 2.  Abort when self‑intersections remain
   // ------------------------------------------------------------------
@@ -206,54 +445,69 @@ void TriMesh::remesh(bool split_long_edges,
   // ------------------------------------------------------------------
   // 4.  Normal isotropic remeshing loop
   // ------------------------------------------------------------------
-  // Convert _fixedEdges to a compatible property map
-
-  // Update remeshing calls to use the property map
+  // Cancellation is only honoured between iterations, where the mesh is
+  // complete; the iterations already done are kept.
+  LoopCGAL::checkpoint("remesh", 0.0);
   if (split_long_edges)
   {
-    if (LoopCGAL::verbose)
-      std::cout << "Splitting long edges before remeshing.\n";
+    LOOPCGAL_DEBUG("Splitting long edges before remeshing.");
     PMP::split_long_edges(
         edges(_mesh), target_edge_length, _mesh,
-        CGAL::parameters::edge_is_constrained_map(_edge_is_constrained_map));
+        CGAL::parameters::edge_is_constrained_map(_fixedEdges));
+    _state.touch();
   }
-  for (int iter = 0; iter < number_of_iterations; ++iter)
+  const bool check_convergence = convergence_tolerance > 0.0;
+  RemeshStats stats;
+  if (check_convergence)
+    stats = remesh_stats(_mesh, target_edge_length);
+  int iter = 0;
+  while (iter < number_of_iterations)
   {
+    if (iter > 0)
+      LoopCGAL::checkpoint("remesh", double(iter) / number_of_iterations);
     if (split_long_edges)
-      if (LoopCGAL::verbose)
-        std::cout << "Splitting long edges in iteration " << iter + 1 << ".\n";
+      LOOPCGAL_DEBUG("Splitting long edges in iteration " << iter + 1 << ".");
     PMP::split_long_edges(
         edges(_mesh), target_edge_length, _mesh,
-        CGAL::parameters::edge_is_constrained_map(_edge_is_constrained_map));
-    if (LoopCGAL::verbose)
-      std::cout << "Remeshing iteration " << iter + 1 << " of "
-                << number_of_iterations << ".\n";
+        CGAL::parameters::edge_is_constrained_map(_fixedEdges));
+    LOOPCGAL_DEBUG("Remeshing iteration " << iter + 1 << " of "
+                      << number_of_iterations << ".");
     PMP::isotropic_remeshing(
         faces(_mesh), target_edge_length, _mesh,
         CGAL::parameters::number_of_iterations(1) // one sub‑iteration per loop
-            .edge_is_constrained_map(_edge_is_constrained_map)
+            .edge_is_constrained_map(_fixedEdges)
             .protect_constraints(protect_constraints)
             .relax_constraints(relax_constraints));
-  }
+    _state.touch();
+    ++iter;
 
-  if (LoopCGAL::verbose)
-  {
-    std::cout << "Refined mesh → " << _mesh.number_of_vertices() << " V, "
-              << _mesh.number_of_faces() << " F\n";
+    if (check_convergence)
+    {
+      RemeshStats current = remesh_stats(_mesh, target_edge_length);
+      const bool converged = remesh_converged(
+          stats, current, convergence_tolerance);
+      stats = current;
+      if (converged)
+        break;
+    }
   }
-  if (!CGAL::is_valid_polygon_mesh(_mesh, LoopCGAL::verbose) && LoopCGAL::verbose)
-    std::cout << "      ! mesh is not a valid polygon mesh after remeshing\n";
+
+  LOOPCGAL_DEBUG("Refined mesh → " << _mesh.number_of_vertices() << " V, "
+                    << _mesh.number_of_faces() << " F in " << iter
+                    << " iteration(s)");
+  _state.touch();
+  validate_mesh(_mesh, _state, ValidationStage::Intermediate,
+                "mesh after remeshing");
+  return iter;
 }
 
 void TriMesh::reverseFaceOrientation()
 {
+  ReleasedLock lock(_mutex);
   // Reverse the face orientation of the mesh
+  // Reversal maps a valid mesh onto a valid mesh, so the cached validity
+  // stays current and no traversal is needed here.
   PMP::reverse_face_orientations(_mesh);
-  if (!CGAL::is_valid_polygon_mesh(_mesh, LoopCGAL::verbose))
-  {
-    std::cerr << "Mesh is not valid after reversing face orientations."
-              << std::endl;
-  }
   
 }
 
@@ -261,25 +515,364 @@ void TriMesh::cutWithSurface(TriMesh &clipper,
                              bool preserve_intersection,
                              bool preserve_intersection_clipper)
 {
-  if (LoopCGAL::verbose)
-  {
-    std::cout << "Cutting mesh with surface." << std::endl;
-  }
+  LoopCGAL::MemoryCall memory("TriMesh.cut_with_surface");
+  ReleasedLock lock(_mutex, clipper._mutex);
+  LOOPCGAL_DEBUG("Cutting mesh with surface.");
+  LoopCGAL::checkpoint("clip");
   bool intersection = PMP::do_intersect(_mesh, clipper._mesh);
   if (intersection)
   {
     // Clip tm with clipper
-    if (LoopCGAL::verbose)
+    LOOPCGAL_DEBUG("Clipping tm with clipper.");
+    const CGAL::Bbox_3 box = PMP::bbox(_mesh);
+    std::vector<Segment> segments;
+    if (!_fix_new_borders)
+      segments = fixed_segments(_mesh, _fixedEdges);
+    LoopCGAL::CancelVisitor<PMP::Corefinement::Default_visitor<TriangleMesh>>
+        visitor;
+    bool flag = PMP::clip(_mesh, clipper._mesh,
+                          CGAL::parameters::clip_volume(false)
+                              .edge_is_constrained_map(_fixedEdges)
+                              .visitor(visitor));
+    if (!flag)
     {
-      std::cout << "Clipping tm with clipper." << std::endl;
+      LOOPCGAL_ERROR("Clipping failed.");
     }
-    bool flag =
-        PMP::clip(_mesh, clipper._mesh, CGAL::parameters::clip_volume(false));
+    _state.touch();
+    if (!_fix_new_borders)
+      keep_fixed_pieces(_mesh, _fixedEdges, segments, box);
+    updateFixedEdges();
+  }
+}
+
+void TriMesh::clipPlane(const pybind11::array_t<double> &normal,
+                        const pybind11::array_t<double> &origin)
+{
+  LoopCGAL::MemoryCall memory("TriMesh.clip_plane");
+  NumpyPlane numpy_plane;
+  numpy_plane.normal = normal;
+  numpy_plane.origin = origin;
+  Plane plane = load_plane(numpy_plane);
+  ReleasedLock lock(_mutex);
+  LoopCGAL::checkpoint("clip");
+  if (!plane_cuts_mesh(_mesh, plane))
+  {
+    LOOPCGAL_DEBUG("Plane does not cut the mesh.");
+    return;
+  }
+  const CGAL::Bbox_3 box = PMP::bbox(_mesh);
+  std::vector<Segment> segments;
+  if (!_fix_new_borders)
+    segments = fixed_segments(_mesh, _fixedEdges);
+  // Up to CGAL 5 a plane clip is a corefinement with a clipper box, which
+  // reports to the visitor
+  LoopCGAL::CancelVisitor<PMP::Corefinement::Default_visitor<TriangleMesh>>
+      visitor;
+  bool flag = PMP::clip(_mesh, plane,
+                        CGAL::parameters::clip_volume(false)
+                            .edge_is_constrained_map(_fixedEdges)
+#if CGAL_VERSION_NR < 1060000000
+                            .visitor(visitor)
+#endif
+  );
+  if (!flag)
+  {
+    LOOPCGAL_ERROR("Clipping failed.");
   }
+  _state.touch();
+  if (!_fix_new_borders)
+    keep_fixed_pieces(_mesh, _fixedEdges, segments, box);
+  updateFixedEdges();
+}
+
+void TriMesh::corefine(TriMesh &other)
+{
+  LoopCGAL::MemoryCall memory("TriMesh.corefine");
+  ReleasedLock lock(_mutex, other._mutex);
+  LOOPCGAL_DEBUG("Corefining mesh with surface.");
+  LoopCGAL::checkpoint("corefine");
+  // The intersection polylines are written into both constraint sets, so
+  // a following remesh keeps the shared curve intact.
+  LoopCGAL::CancelVisitor<PMP::Corefinement::Default_visitor<TriangleMesh>>
+      visitor;
+  PMP::corefine(
+      _mesh, other._mesh,
+      CGAL::parameters::edge_is_constrained_map(_fixedEdges).visitor(visitor),
+      CGAL::parameters::edge_is_constrained_map(other._fixedEdges));
+  LoopCGAL::checkpoint("corefine", 1.0);
+  _state.touch();
+  other._state.touch();
+  updateFixedEdges();
+  other.updateFixedEdges();
+  LOOPCGAL_DEBUG("Corefinement done, " << countFixedEdges()
+                    << " fixed edges.");
+}
+
+bool TriMesh::removeDegenerateFaces()
+{
+  ReleasedLock lock(_mutex);
+  LoopCGAL::checkpoint("cleanup");
+  bool flag = clean_degenerate_faces(_mesh, _fixedEdges);
+  if (!flag)
+  {
+    LOOPCGAL_WARNING("Removing degenerate faces failed.");
+  }
+  _state.touch();
+  updateFixedEdges();
+  return flag;
+}
+
+void TriMesh::stitch()
+{
+  ReleasedLock lock(_mutex);
+  LoopCGAL::checkpoint("stitch");
+  stitch_mesh(_mesh);
+  _state.touch();
+  updateFixedEdges();
+}
+
+void TriMesh::updateFixedEdges()
+{
+  // Removed and reused edge slots are reset by Surface_mesh itself; only
+  // the opt-in border constraint needs work here.
+  if (!_fix_new_borders)
+    return;
+  for (const auto &e : collect_border_edges(_mesh))
+    _fixedEdges[e] = true;
 }
 
 NumpyMesh TriMesh::save(double area_threshold,
                         double duplicate_vertex_threshold)
 {
-  return export_mesh(_mesh, area_threshold, duplicate_vertex_threshold);
-}
\ No newline at end of file
+  LoopCGAL::MemoryCall memory("TriMesh.save");
+  // The copy becomes the result, so later edits leave it untouched
+  TriangleMesh copy;
+  {
+    ReleasedLock lock(_mutex);
+    copy = _mesh;
+    copy.collect_garbage();
+  }
+  LoopCGAL::checkpoint("export");
+  return export_mesh(std::move(copy), area_threshold,
+                     duplicate_vertex_threshold);
+}
+
+// ---------------------------------------------------------------------------
+// Pickle support: raw dump of the Surface_mesh connectivity arrays
+// ---------------------------------------------------------------------------
+namespace
+{
+  constexpr char kSnapshotMagic[4] = {'L', 'C', 'T', 'M'};
+  constexpr std::uint32_t kSnapshotVersion = 2;
+  // Bits of SnapshotHeader::flags
+  constexpr std::uint32_t kFixNewBordersFlag = 1;
+  constexpr std::uint32_t kNullIndex =
+      (std::numeric_limits<std::uint32_t>::max)();
+
+  struct SnapshotHeader
+  {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t flags;
+    std::uint32_t reserved;
+    std::uint64_t n_vertices;
+    std::uint64_t n_halfedges;
+    std::uint64_t n_faces;
+    std::uint64_t n_fixed_edges;
+  };
+
+  template <typename T>
+  char *write_array(char *out, const std::vector<T> &values)
+  {
+    std::memcpy(out, values.data(), values.size() * sizeof(T));
+    return out + values.size() * sizeof(T);
+  }
+
+  template <typename T>
+  const char *read_array(const char *in, std::vector<T> &values,
+                         std::size_t n)
+  {
+    values.resize(n);
+    std::memcpy(values.data(), in, n * sizeof(T));
+    return in + n * sizeof(T);
+  }
+} // namespace
+
+std::string TriMesh::serialize() const
+{
+  ReleasedLock lock(_mutex);
+  using VIndex = TriangleMesh::Vertex_index;
+  using HIndex = TriangleMesh::Halfedge_index;
+  using FIndex = TriangleMesh::Face_index;
+
+  // Removed elements still occupy slots in the property arrays, so build
+  // compact index maps first. Without garbage these are the identity.
+  const std::size_t v_slots =
+      _mesh.number_of_vertices() + _mesh.number_of_removed_vertices();
+  const std::size_t h_slots =
+      _mesh.number_of_halfedges() + _mesh.number_of_removed_halfedges();
+  const std::size_t f_slots =
+      _mesh.number_of_faces() + _mesh.number_of_removed_faces();
+  std::vector<std::uint32_t> vmap(v_slots, kNullIndex);
+  std::vector<std::uint32_t> hmap(h_slots, kNullIndex);
+  std::vector<std::uint32_t> fmap(f_slots, kNullIndex);
+
+  std::uint32_t next = 0;
+  for (VIndex v : _mesh.vertices())
+    vmap[v.idx()] = next++;
+  next = 0;
+  for (auto e : _mesh.edges())
+  {
+    HIndex h = _mesh.halfedge(e);
+    hmap[h.idx()] = next++;
+    hmap[_mesh.opposite(h).idx()] = next++;
+  }
+  next = 0;
+  for (FIndex f : _mesh.faces())
+    fmap[f.idx()] = next++;
+
+  auto remap = [](const std::vector<std::uint32_t> &map, std::uint32_t idx)
+  { return idx == kNullIndex ? kNullIndex : map[idx]; };
+
+  const std::size_t nv = _mesh.number_of_vertices();
+  const std::size_t nh = _mesh.number_of_halfedges();
+  const std::size_t nf = _mesh.number_of_faces();
+
+  std::vector<double> points;
+  std::vector<std::uint32_t> v_halfedge, h_target(nh), h_next(nh), h_face(nh),
+      f_halfedge, fixed;
+  points.reserve(3 * nv);
+  v_halfedge.reserve(nv);
+  for (VIndex v : _mesh.vertices())
+  {
+    const Point &p = _mesh.point(v);
+    points.push_back(p.x());
+    points.push_back(p.y());
+    points.push_back(p.z());
+    v_halfedge.push_back(remap(hmap, _mesh.halfedge(v).idx()));
+  }
+  for (HIndex h : _mesh.halfedges())
+  {
+    const std::uint32_t i = hmap[h.idx()];
+    h_target[i] = vmap[_mesh.target(h).idx()];
+    h_next[i] = hmap[_mesh.next(h).idx()];
+    h_face[i] = remap(fmap, _mesh.face(h).idx());
+  }
+  f_halfedge.reserve(nf);
+  for (FIndex f : _mesh.faces())
+    f_halfedge.push_back(hmap[_mesh.halfedge(f).idx()]);
+  for (auto e : _mesh.edges())
+    if (_fixedEdges[e])
+      fixed.push_back(hmap[_mesh.halfedge(e).idx()] / 2);
+
+  SnapshotHeader header;
+  std::memcpy(header.magic, kSnapshotMagic, sizeof(kSnapshotMagic));
+  header.version = kSnapshotVersion;
+  header.flags = _fix_new_borders ? kFixNewBordersFlag : 0;
+  header.reserved = 0;
+  header.n_vertices = nv;
+  header.n_halfedges = nh;
+  header.n_faces = nf;
+  header.n_fixed_edges = fixed.size();
+
+  std::string state(sizeof(SnapshotHeader) + points.size() * sizeof(double) +
+                        (nv + 3 * nh + nf + fixed.size()) *
+                            sizeof(std::uint32_t),
+                    '\0');
+  char *out = &state[0];
+  std::memcpy(out, &header, sizeof(SnapshotHeader));
+  out += sizeof(SnapshotHeader);
+  out = write_array(out, points);
+  out = write_array(out, v_halfedge);
+  out = write_array(out, h_target);
+  out = write_array(out, h_next);
+  out = write_array(out, h_face);
+  out = write_array(out, f_halfedge);
+  write_array(out, fixed);
+  return state;
+}
+
+std::unique_ptr<TriMesh> TriMesh::deserialize(const char *data,
+                                              std::size_t size)
+{
+  using VIndex = TriangleMesh::Vertex_index;
+  using HIndex = TriangleMesh::Halfedge_index;
+  using FIndex = TriangleMesh::Face_index;
+
+  SnapshotHeader header;
+  if (size < sizeof(SnapshotHeader))
+    throw std::runtime_error("TriMesh state is truncated.");
+  std::memcpy(&header, data, sizeof(SnapshotHeader));
+  if (std::memcmp(header.magic, kSnapshotMagic, sizeof(kSnapshotMagic)) != 0 ||
+      header.version != kSnapshotVersion)
+    throw std::runtime_error("TriMesh state has an unknown format.");
+
+  const std::size_t nv = header.n_vertices;
+  const std::size_t nh = header.n_halfedges;
+  const std::size_t nf = header.n_faces;
+  const std::size_t nfixed = header.n_fixed_edges;
+  if (nh % 2 != 0 ||
+      size != sizeof(SnapshotHeader) + 3 * nv * sizeof(double) +
+                  (nv + 3 * nh + nf + nfixed) * sizeof(std::uint32_t))
+    throw std::runtime_error("TriMesh state has an inconsistent size.");
+
+  std::vector<double> points;
+  std::vector<std::uint32_t> v_halfedge, h_target, h_next, h_face, f_halfedge,
+      fixed;
+  const char *in = data + sizeof(SnapshotHeader);
+  in = read_array(in, points, 3 * nv);
+  in = read_array(in, v_halfedge, nv);
+  in = read_array(in, h_target, nh);
+  in = read_array(in, h_next, nh);
+  in = read_array(in, h_face, nh);
+  in = read_array(in, f_halfedge, nf);
+  read_array(in, fixed, nfixed);
+
+  // Reject out-of-range indices before they reach the mesh
+  auto in_range = [](const std::vector<std::uint32_t> &values, std::size_t n,
+                     bool allow_null)
+  {
+    for (std::uint32_t i : values)
+      if (i >= n && !(allow_null && i == kNullIndex))
+        return false;
+    return true;
+  };
+  if (!in_range(v_halfedge, nh, true) || !in_range(h_target, nv, false) ||
+      !in_range(h_next, nh, false) || !in_range(h_face, nf, true) ||
+      !in_range(f_halfedge, nh, false) || !in_range(fixed, nh / 2, false))
+    throw std::runtime_error("TriMesh state contains invalid indices.");
+
+  std::unique_ptr<TriMesh> mesh(new TriMesh());
+  TriangleMesh &tm = mesh->_mesh;
+  tm.reserve(nv, nh / 2, nf);
+  for (std::size_t i = 0; i < nv; ++i)
+    tm.add_vertex(Point(points[3 * i], points[3 * i + 1], points[3 * i + 2]));
+  for (std::size_t i = 0; i < nh / 2; ++i)
+    tm.add_edge();
+  for (std::size_t i = 0; i < nf; ++i)
+    tm.add_face();
+
+  // Null entries map onto Surface_mesh's own null index (max uint32)
+  for (std::size_t i = 0; i < nv; ++i)
+    tm.set_halfedge(VIndex(i), HIndex(v_halfedge[i]));
+  for (std::size_t i = 0; i < nh; ++i)
+  {
+    tm.set_target(HIndex(i), VIndex(h_target[i]));
+    tm.set_next(HIndex(i), HIndex(h_next[i]));
+    tm.set_face(HIndex(i), FIndex(h_face[i]));
+  }
+  for (std::size_t i = 0; i < nf; ++i)
+    tm.set_halfedge(FIndex(i), HIndex(f_halfedge[i]));
+
+  mesh->_fixedEdges =
+      tm.add_property_map<TriangleMesh::Edge_index, bool>("e:fixed", false)
+          .first;
+  mesh->_fix_new_borders = (header.flags & kFixNewBordersFlag) != 0;
+  for (std::uint32_t e : fixed)
+    mesh->_fixedEdges[TriangleMesh::Edge_index(e)] = true;
+
+  LOOPCGAL_DEBUG("Restored mesh with " << tm.number_of_vertices()
+                    << " vertices, " << tm.number_of_faces() << " faces and "
+                    << fixed.size() << " fixed edges.");
+  return mesh;
+}
@@ -6,8 +6,13 @@
 #include <CGAL/Surface_mesh.h>
 #include <CGAL/Vector_3.h>
 #include <CGAL/property_map.h>
+#include "aabb.h"
+#include "meshstate.h"
 #include <numpymesh.h>
 #include <pybind11/numpy.h>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <utility> // For std::pair
 #include <vector>
 typedef CGAL::Simple_cartesian<double> Kernel;
@@ -15,35 +20,91 @@ typedef Kernel::Point_3 Point;
 typedef CGAL::Surface_mesh<Point> TriangleMesh;
 typedef CGAL::Plane_3<Kernel> Plane;
 typedef CGAL::Vector_3<Kernel> Vector;
+typedef TriangleMesh::Property_map<TriangleMesh::Edge_index, bool> EdgeFlagMap;
 class TriMesh
 {
 public:
         // Constructor
         TriMesh(const std::vector<std::vector<int>> &triangles,
                 const std::vector<std::pair<double, double>> &vertices);
-        TriMesh(const pybind11::array_t<double> &vertices,
-                const pybind11::array_t<int> &triangles);
+        // Any float / integer dtype and any triangle layout, read in place
+        // (see arrayview.h); offsets is empty unless triangles is VTK
+        // connectivity.
+        TriMesh(const pybind11::array &vertices,
+                const pybind11::array &triangles,
+                const pybind11::array &offsets = pybind11::array());
+        // A mesh returned by save() or a clip function; its Surface_mesh
+        // is copied when it has one, otherwise its arrays are loaded.
+        explicit TriMesh(const NumpyMesh &mesh);
 
         // Method to cut the mesh with another surface object
         void cutWithSurface(TriMesh &surface, 
                             bool preserve_intersection = false,
                             bool preserve_intersection_clipper = false);
 
+        // In-place operations, so a chain of edits never leaves C++. Fixed
+        // edges split by an operation stay fixed, and corefine fixes the
+        // intersection curves. With fixNewBorders the borders an operation
+        // creates (e.g. a clip line) are fixed as well; off by default.
+        // They run with the GIL released and stop at the checkpoints of
+        // the current cancel token, inside CGAL through its visitors.
+        void setFixNewBorders(bool fix);
+        bool fixNewBorders() const;
+        void clipPlane(const pybind11::array_t<double> &normal,
+                       const pybind11::array_t<double> &origin);
+        void corefine(TriMesh &other);
+        bool removeDegenerateFaces();
+        void stitch();
+
         // Method to remesh the triangle mesh
-        void remesh(bool split_long_edges,  double target_edge_length,
-                    int number_of_iterations, bool protect_constraints,
-                    bool relax_constraints);
+        // Returns the number of iterations run; with convergence_tolerance
+        // > 0 the loop stops early once the edge lengths settle.
+        int remesh(bool split_long_edges, double target_edge_length,
+                   int number_of_iterations, bool protect_constraints,
+                   bool relax_constraints, double convergence_tolerance = 0.01);
         void init();
         // Getters for mesh properties
         void reverseFaceOrientation();
         NumpyMesh save(double area_threshold, double duplicate_vertex_threshold);
         void add_fixed_edges(const pybind11::array_t<int> &pairs);
+        std::size_t fixedEdgeCount() const;
+
+        // Point queries against the faces, for an (n, 3) array of any float
+        // dtype. Run in parallel chunks with the GIL released and the mesh
+        // locked, so another thread cannot edit it mid-query. The sign of
+        // the distance is that of the offset along the face normal, or the
+        // angle-weighted pseudo-normal when the closest point is on an
+        // edge or a vertex, i.e. positive on the side the faces point to.
+        pybind11::array_t<double> signedDistance(const pybind11::array &points);
+        pybind11::array_t<double> closestPoint(const pybind11::array &points);
+
+        // Binary snapshot of the half-edge structure, the fixed edges and
+        // fixNewBorders, used for pickling. deserialize() rebuilds the
+        // mesh in linear time.
+        std::string serialize() const;
+        static std::unique_ptr<TriMesh> deserialize(const char *data,
+                                                    std::size_t size);
 
 private:
-        std::set<TriangleMesh::Edge_index> _fixedEdges;
+        TriMesh() = default;
+        void updateFixedEdges();
+        std::size_t countFixedEdges() const;
+        // AABB tree over the faces, rebuilt when the revision moves on
+        const FaceTree &faceTree();
         TriangleMesh _mesh; // The underlying CGAL surface mesh
-        CGAL::Boolean_property_map<std::set<TriangleMesh::Edge_index>>
-            _edge_is_constrained_map;
+        // Edge property, so it follows the edges through splits, removals
+        // and slot reuse instead of holding indices that may go stale
+        EdgeFlagMap _fixedEdges;
+        bool _fix_new_borders = false;
+        MeshState _state;   // Revision counter and cached validity
+        std::unique_ptr<FaceTree> _tree;
+        std::uint64_t _tree_revision = 0;
+        // Held by every method while it reads or edits the mesh or the
+        // tree, so calls on one mesh from several threads run one at a
+        // time. Taken with the GIL released. Recursive, so a mesh can be
+        // cut with itself and a progress callback can read the mesh its
+        // call is editing.
+        mutable std::recursive_mutex _mutex;
 };
 
 #endif // MESH_HANDLER_H
\ No newline at end of file
@@ -0,0 +1,25 @@
+#include "meshstate.h"
+#include "globals.h"
+#include <CGAL/boost/graph/helpers.h>
+
+bool validate_mesh(const TriangleMesh &tm, MeshState &state,
+                   ValidationStage stage, const char *what) {
+  const LoopCGAL::ValidationLevel level = LoopCGAL::get_validation_level();
+  const bool wanted =
+      level == LoopCGAL::ValidationLevel::Paranoid ||
+      (level == LoopCGAL::ValidationLevel::InputsOnly &&
+       stage == ValidationStage::Input);
+  if (state.is_validated())
+    return state.valid;
+  if (!wanted)
+    return true;
+  state.valid = CGAL::is_valid_polygon_mesh(tm);
+  state.validated_revision = state.revision;
+  if (!state.valid) {
+    if (stage == ValidationStage::Input)
+      LOOPCGAL_WARNING(what << " is not a valid polygon mesh.");
+    else
+      LOOPCGAL_DEBUG("      ! " << what << " is not a valid polygon mesh");
+  }
+  return state.valid;
+}
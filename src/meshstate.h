@@ -0,0 +1,27 @@
+#ifndef MESHSTATE_H
+#define MESHSTATE_H
+#include <CGAL/Simple_cartesian.h>
+#include <CGAL/Surface_mesh.h>
+#include <cstdint>
+
+typedef CGAL::Simple_cartesian<double> Kernel;
+typedef Kernel::Point_3 Point;
+typedef CGAL::Surface_mesh<Point> TriangleMesh;
+
+// Structural revision of a mesh. Modifying operations call touch(); the
+// cached validity result is reused until the next touch().
+struct MeshState {
+  std::uint64_t revision = 0;
+  std::uint64_t validated_revision = ~std::uint64_t(0);
+  bool valid = false;
+  void touch() { ++revision; }
+  bool is_validated() const { return validated_revision == revision; }
+};
+enum class ValidationStage { Input, Intermediate };
+// Runs CGAL::is_valid_polygon_mesh when the module validation level asks for
+// this stage and the state is stale. Returns true when the mesh is known or
+// assumed valid.
+bool validate_mesh(const TriangleMesh &tm, MeshState &state,
+                   ValidationStage stage, const char *what);
+
+#endif // MESHSTATE_H
@@ -1,6 +1,23 @@
 #include "meshutils.h"
 #include "mesh.h"
 #include "globals.h"
+#include "attributes.h"
+#include "arrayview.h"
+#include <CGAL/Polygon_mesh_processing/bbox.h>
+#include <CGAL/Polygon_mesh_processing/measure.h>
+#include <CGAL/Polygon_mesh_processing/merge_border_vertices.h>
+#include <CGAL/Polygon_mesh_processing/repair.h>
+#include <CGAL/Polygon_mesh_processing/stitch_borders.h>
+#include <CGAL/Spatial_sort_traits_adapter_3.h>
+#include <CGAL/hilbert_sort.h>
+#include <CGAL/property_map.h>
+#include <CGAL/version.h>
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <unordered_map>
+#include <unordered_set>
+namespace PMP = CGAL::Polygon_mesh_processing;
 std::set<TriangleMesh::Edge_index>
 collect_border_edges(const TriangleMesh &tm) {
   std::set<TriangleMesh::Edge_index> border_edges;
@@ -11,6 +28,177 @@ collect_border_edges(const TriangleMesh &tm) {
   }
   return border_edges;
 }
+std::vector<std::size_t> hilbert_order(const std::vector<Point> &points) {
+  typedef CGAL::Spatial_sort_traits_adapter_3<
+      Kernel, CGAL::Pointer_property_map<Point>::const_type>
+      SortTraits;
+  std::vector<std::size_t> order(points.size());
+  std::iota(order.begin(), order.end(), std::size_t(0));
+  CGAL::hilbert_sort(order.begin(), order.end(),
+                     SortTraits(CGAL::make_property_map(points)));
+  return order;
+}
+void load_arrays(TriangleMesh &tm, const pybind11::array &vertices,
+                 const pybind11::array &triangles,
+                 const pybind11::array &offsets, bool spatial_order) {
+  std::vector<TriangleMesh::Vertex_index> vertex_indices;
+  LoopCGAL::visit_coordinates(vertices, [&](auto verts) {
+    const ssize_t n = verts.shape(0);
+    tm.reserve(tm.number_of_vertices() + n, 0, 0);
+    if (!spatial_order) {
+      vertex_indices.reserve(n);
+      for (ssize_t i = 0; i < n; ++i)
+        vertex_indices.push_back(
+            tm.add_vertex(Point(verts(i, 0), verts(i, 1), verts(i, 2))));
+      return;
+    }
+    std::vector<Point> points;
+    points.reserve(n);
+    for (ssize_t i = 0; i < n; ++i)
+      points.emplace_back(verts(i, 0), verts(i, 1), verts(i, 2));
+    vertex_indices.resize(n);
+    for (std::size_t row : hilbert_order(points))
+      vertex_indices[row] = tm.add_vertex(points[row]);
+  });
+  LoopCGAL::visit_triangles(triangles, offsets, [&](auto tris) {
+    const ssize_t n = tris.size();
+    for (ssize_t i = 0; i < n; ++i)
+      for (int k = 0; k < 3; ++k)
+        if (!LoopCGAL::index_in_range(tris(i, k), vertex_indices.size()))
+          throw std::invalid_argument("Triangle index out of range.");
+    if (!spatial_order) {
+      for (ssize_t i = 0; i < n; ++i)
+        tm.add_face(vertex_indices[tris(i, 0)], vertex_indices[tris(i, 1)],
+                    vertex_indices[tris(i, 2)]);
+      return;
+    }
+    // Faces follow the Hilbert order of their centroids
+    std::vector<Point> centroids;
+    centroids.reserve(n);
+    for (ssize_t i = 0; i < n; ++i)
+      centroids.push_back(CGAL::centroid(tm.point(vertex_indices[tris(i, 0)]),
+                                         tm.point(vertex_indices[tris(i, 1)]),
+                                         tm.point(vertex_indices[tris(i, 2)])));
+    for (std::size_t i : hilbert_order(centroids))
+      tm.add_face(vertex_indices[tris(i, 0)], vertex_indices[tris(i, 1)],
+                  vertex_indices[tris(i, 2)]);
+  });
+}
+NumpyPolylines export_polylines(const std::vector<Polylines> &groups) {
+  std::size_t n_lines = 0, n_points = 0;
+  for (const Polylines &group : groups)
+    for (const auto &line : group) {
+      ++n_lines;
+      n_points += line.size();
+    }
+
+  NumpyPolylines result;
+  result.vertices = pybind11::array_t<double>(
+      {static_cast<ssize_t>(n_points), static_cast<ssize_t>(3)});
+  result.offsets =
+      pybind11::array_t<std::int64_t>(static_cast<ssize_t>(n_lines + 1));
+  result.ids = pybind11::array_t<int>(static_cast<ssize_t>(n_lines));
+  auto vbuf = result.vertices.mutable_unchecked<2>();
+  auto obuf = result.offsets.mutable_unchecked<1>();
+  auto ibuf = result.ids.mutable_unchecked<1>();
+
+  ssize_t row = 0, line_index = 0;
+  obuf(0) = 0;
+  for (std::size_t g = 0; g < groups.size(); ++g)
+    for (const auto &line : groups[g]) {
+      for (const Point &p : line) {
+        vbuf(row, 0) = p.x();
+        vbuf(row, 1) = p.y();
+        vbuf(row, 2) = p.z();
+        ++row;
+      }
+      ibuf(line_index) = static_cast<int>(g);
+      obuf(++line_index) = row;
+    }
+  LOOPCGAL_DEBUG("Exported " << n_lines << " polylines with " << n_points
+                             << " points.");
+  return result;
+}
+namespace {
+template <typename EdgeIsConstrainedMap>
+bool remove_degenerate(TriangleMesh &tm, EdgeIsConstrainedMap ecm) {
+#if CGAL_VERSION_NR >= 1060000000
+  return PMP::remove_almost_degenerate_faces(
+      faces(tm), tm, CGAL::parameters::edge_is_constrained_map(ecm));
+#else
+  return PMP::remove_degenerate_faces(
+      faces(tm), tm, CGAL::parameters::edge_is_constrained_map(ecm));
+#endif
+}
+} // namespace
+bool clean_degenerate_faces(
+    TriangleMesh &tm,
+    const std::set<TriangleMesh::Edge_index> &protected_edges) {
+  return remove_degenerate(tm,
+                           CGAL::make_boolean_property_map(protected_edges));
+}
+bool clean_degenerate_faces(TriangleMesh &tm, EdgeFlagMap protected_edges) {
+  return remove_degenerate(tm, protected_edges);
+}
+void stitch_mesh(TriangleMesh &tm) {
+  LOOPCGAL_DEBUG("  – stitching borders…");
+  PMP::stitch_borders(tm);
+  LOOPCGAL_DEBUG("  – merging dup vertices…");
+  PMP::merge_duplicated_vertices_in_boundary_cycles(tm);
+}
+RemeshStats remesh_stats(const TriangleMesh &tm, double target_edge_length) {
+  // Same band as PMP::isotropic_remeshing: edges longer than 4/3 L are split
+  // and edges shorter than 4/5 L are collapsed.
+  const double high = 4.0 / 3.0 * target_edge_length;
+  const double low = 4.0 / 5.0 * target_edge_length;
+  RemeshStats stats;
+  stats.n_vertices = tm.number_of_vertices();
+  stats.n_faces = tm.number_of_faces();
+  stats.n_edges = tm.number_of_edges();
+  double sum = 0.0, sum_sq = 0.0;
+  std::size_t n = 0;
+  for (auto e : tm.edges()) {
+    const double l = PMP::edge_length(e, tm);
+    sum += l;
+    sum_sq += l * l;
+    ++n;
+    if (l > high || l < low)
+      ++stats.n_out_of_band;
+  }
+  if (n > 0) {
+    stats.mean_edge_length = sum / n;
+    stats.std_edge_length = std::sqrt(std::max(
+        0.0, sum_sq / n - stats.mean_edge_length * stats.mean_edge_length));
+  }
+  return stats;
+}
+bool remesh_converged(const RemeshStats &previous, const RemeshStats &current,
+                      double tolerance) {
+  auto relative_change = [](double a, double b) {
+    return std::abs(a - b) / std::max(std::abs(b), 1e-12);
+  };
+  // Counts are compared against their own size, so every term is a fraction
+  auto count_change = [](std::size_t a, std::size_t b, std::size_t size) {
+    return double(a > b ? a - b : b - a) / double(std::max<std::size_t>(size, 1));
+  };
+  const double vertex_change =
+      count_change(current.n_vertices, previous.n_vertices, current.n_vertices);
+  const double face_change =
+      count_change(current.n_faces, previous.n_faces, current.n_faces);
+  const double band_change = count_change(
+      current.n_out_of_band, previous.n_out_of_band, current.n_edges);
+  const double mean_change =
+      relative_change(current.mean_edge_length, previous.mean_edge_length);
+  const double std_change =
+      relative_change(current.std_edge_length, previous.std_edge_length);
+  LOOPCGAL_DEBUG("      vertices " << vertex_change << ", faces " << face_change
+                                   << ", out of band " << band_change
+                                   << ", mean edge " << mean_change
+                                   << ", std edge " << std_change);
+  return vertex_change < tolerance && face_change < tolerance &&
+         band_change < tolerance && mean_change < tolerance &&
+         std_change < tolerance;
+}
 double calculate_triangle_area(const std::array<double, 3> &v1,
                                const std::array<double, 3> &v2,
                                const std::array<double, 3> &v3) {
@@ -31,76 +219,316 @@ double calculate_triangle_area(const std::array<double, 3> &v1,
   // Area is half the magnitude of the cross product
   return 0.5 * magnitude;
 }
+namespace {
+// Writes the triangles straight into the requested VTK / numpy layout so
+// that neither side has to re-pack the connectivity.
+template <typename Index>
+void store_triangles(const std::vector<std::array<int, 3>> &triangles,
+                     LoopCGAL::FaceLayout layout, NumpyMesh &result) {
+  const ssize_t n = static_cast<ssize_t>(triangles.size());
+  if (layout == LoopCGAL::FaceLayout::Rows) {
+    pybind11::array_t<Index> rows({n, static_cast<ssize_t>(3)});
+    auto buf = rows.template mutable_unchecked<2>();
+    for (ssize_t i = 0; i < n; ++i)
+      for (int k = 0; k < 3; ++k)
+        buf(i, k) = static_cast<Index>(triangles[i][k]);
+    result.triangles = rows;
+    return;
+  }
+  const ssize_t stride = layout == LoopCGAL::FaceLayout::Padded ? 4 : 3;
+  pybind11::array_t<Index> cells(n * stride);
+  auto buf = cells.template mutable_unchecked<1>();
+  for (ssize_t i = 0; i < n; ++i) {
+    if (stride == 4)
+      buf(4 * i) = 3;
+    for (int k = 0; k < 3; ++k)
+      buf(i * stride + (stride - 3) + k) = static_cast<Index>(triangles[i][k]);
+  }
+  result.triangles = cells;
+  if (layout == LoopCGAL::FaceLayout::Offsets) {
+    pybind11::array_t<Index> offsets(n + 1);
+    auto obuf = offsets.template mutable_unchecked<1>();
+    for (ssize_t i = 0; i <= n; ++i)
+      obuf(i) = static_cast<Index>(3 * i);
+    result.offsets = offsets;
+  }
+}
+} // namespace
 // ---------------------------------------------------------------------------
 // Efficient export: linear‑time duplicate detection via quantised hash grid
 // ---------------------------------------------------------------------------
-NumpyMesh export_mesh(const TriangleMesh &tm, double area_threshold,
-                      double duplicate_vertex_threshold) {
-  using VIndex = TriangleMesh::Vertex_index;
-
+namespace {
+struct ExportData {
   std::vector<std::array<double, 3>> vertices; // unique coords
   std::vector<std::array<int, 3>> triangles;   // face indices
-  std::map<VIndex, int> vertex_index_map;      // CGAL → compact
+  std::size_t n_skipped = 0;                   // faces below the threshold
+};
 
-  // —‑‑‑‑‑ 1.  Build unique‑vertex list ----------------------------------
-  struct QKey {
-    long long x, y, z;
-    bool operator==(const QKey &o) const {
-      return x == o.x && y == o.y && z == o.z;
-    }
-  };
-  struct QHash {
-    std::size_t operator()(const QKey &k) const noexcept {
-      std::size_t h1 = std::hash<long long>{}(k.x);
-      std::size_t h2 = std::hash<long long>{}(k.y);
-      std::size_t h3 = std::hash<long long>{}(k.z);
-      return h1 ^ (h2 << 1) ^ (h3 << 2);
-    }
-  };
+// Cell of the duplicate-detection grid
+struct QKey {
+  long long x, y, z;
+  bool operator==(const QKey &o) const {
+    return x == o.x && y == o.y && z == o.z;
+  }
+};
+struct QHash {
+  std::size_t operator()(const QKey &k) const noexcept {
+    std::size_t h1 = std::hash<long long>{}(k.x);
+    std::size_t h2 = std::hash<long long>{}(k.y);
+    std::size_t h3 = std::hash<long long>{}(k.z);
+    return h1 ^ (h2 << 1) ^ (h3 << 2);
+  }
+};
+
+QKey grid_cell(const Point &p, double inv) {
+  return {llround(p.x() * inv), llround(p.y() * inv), llround(p.z() * inv)};
+}
 
+// True when collect_export would keep every vertex and face of tm as they
+// are, found without building its arrays; stops at the first merge or
+// dropped face.
+bool exports_unchanged(const TriangleMesh &tm, double area_threshold,
+                       double duplicate_vertex_threshold) {
+  if (tm.has_garbage() || LoopCGAL::get_spatial_ordering())
+    return false;
+  const double inv = 1.0 / duplicate_vertex_threshold;
+  std::unordered_set<QKey, QHash> cells;
+  cells.reserve(tm.number_of_vertices());
+  for (auto v : tm.vertices())
+    if (!cells.insert(grid_cell(tm.point(v), inv)).second)
+      return false;
+  for (auto f : tm.faces()) {
+    const auto h = tm.halfedge(f);
+    const Point &a = tm.point(tm.source(h));
+    const Point &b = tm.point(tm.target(h));
+    const Point &c = tm.point(tm.target(tm.next(h)));
+    if (calculate_triangle_area({a.x(), a.y(), a.z()}, {b.x(), b.y(), b.z()},
+                                {c.x(), c.y(), c.z()}) < area_threshold)
+      return false;
+  }
+  return true;
+}
+
+ExportData
+collect_export(const TriangleMesh &tm, double area_threshold,
+               double duplicate_vertex_threshold,
+               std::vector<TriangleMesh::Face_index> *exported_faces) {
+  using VIndex = TriangleMesh::Vertex_index;
+
+  ExportData data;
+  std::vector<std::array<double, 3>> &vertices = data.vertices;
+  std::vector<std::array<int, 3>> &triangles = data.triangles;
+  // CGAL → compact, indexed by slot so freed slots cost no lookups
+  std::vector<int> vertex_index_map(tm.number_of_vertices() +
+                                    tm.number_of_removed_vertices());
+
+  // —‑‑‑‑‑ 1.  Build unique‑vertex list ----------------------------------
   const double inv = 1.0 / duplicate_vertex_threshold; // quantisation
   std::unordered_map<QKey, int, QHash> qmap;           // grid → index
 
   int next_idx = 0;
   for (VIndex v : tm.vertices()) {
     const auto &p = tm.point(v);
-    QKey key{llround(p.x() * inv), llround(p.y() * inv), llround(p.z() * inv)};
+    const QKey key = grid_cell(p, inv);
 
     auto it = qmap.find(key);
     if (it == qmap.end()) { // first occurrence → store
       qmap[key] = next_idx;
       vertices.push_back({p.x(), p.y(), p.z()});
-      vertex_index_map[v] = next_idx++;
+      vertex_index_map[v.idx()] = next_idx++;
     } else { // duplicate → alias
-      vertex_index_map[v] = it->second;
+      vertex_index_map[v.idx()] = it->second;
     }
   }
 
-  if (LoopCGAL::verbose) {
-    std::cout << "Vertices after remeshing: " << vertices.size() << '\n';
-    std::cout << "Duplicate‑detection grid cells: " << qmap.size() << '\n';
-  }
+  LOOPCGAL_DEBUG("Vertices after remeshing: " << vertices.size());
+  LOOPCGAL_DEBUG("Duplicate‑detection grid cells: " << qmap.size());
 
   // —‑‑‑‑‑ 2.  Build triangle list, skipping tiny faces ------------------
   for (auto f : tm.faces()) {
     std::array<int, 3> tri;
     int k = 0;
     for (auto he : CGAL::halfedges_around_face(tm.halfedge(f), tm))
-      tri[k++] = vertex_index_map[CGAL::target(he, tm)];
+      tri[k++] = vertex_index_map[CGAL::target(he, tm).idx()];
 
     double area = calculate_triangle_area(vertices[tri[0]], vertices[tri[1]],
                                           vertices[tri[2]]);
 
-    if (area >= area_threshold)
+    if (area >= area_threshold) {
       triangles.push_back(tri);
-    else if (LoopCGAL::verbose)
-      std::cout << "Skipping degenerate face (A=" << area << ")\n";
+      if (exported_faces)
+        exported_faces->push_back(f);
+    } else
+      ++data.n_skipped;
+  }
+
+  LOOPCGAL_DEBUG("Kept " << triangles.size() << " triangles, skipped "
+                         << data.n_skipped << " degenerate faces.");
+  return data;
+}
+
+// —‑‑‑‑‑ 2b. Optional Hilbert order of the exported arrays ---------------
+void hilbert_reorder(ExportData &data,
+                     std::vector<TriangleMesh::Face_index> *exported_faces) {
+  std::vector<std::array<double, 3>> &vertices = data.vertices;
+  std::vector<std::array<int, 3>> &triangles = data.triangles;
+  std::vector<Point> points;
+  points.reserve(vertices.size());
+  for (const auto &v : vertices)
+    points.emplace_back(v[0], v[1], v[2]);
+  const std::vector<std::size_t> order = hilbert_order(points);
+  std::vector<int> rank(vertices.size());
+  std::vector<std::array<double, 3>> sorted(vertices.size());
+  for (std::size_t r = 0; r < order.size(); ++r) {
+    sorted[r] = vertices[order[r]];
+    rank[order[r]] = static_cast<int>(r);
+  }
+  vertices.swap(sorted);
+
+  std::vector<Point> centroids;
+  centroids.reserve(triangles.size());
+  for (auto &tri : triangles) {
+    for (int &corner : tri)
+      corner = rank[corner];
+    centroids.push_back(CGAL::centroid(points[order[tri[0]]],
+                                       points[order[tri[1]]],
+                                       points[order[tri[2]]]));
+  }
+  const std::vector<std::size_t> face_order = hilbert_order(centroids);
+  std::vector<std::array<int, 3>> sorted_triangles(triangles.size());
+  for (std::size_t r = 0; r < face_order.size(); ++r)
+    sorted_triangles[r] = triangles[face_order[r]];
+  triangles.swap(sorted_triangles);
+  if (exported_faces && exported_faces->size() == face_order.size()) {
+    std::vector<TriangleMesh::Face_index> sorted_faces(face_order.size());
+    for (std::size_t r = 0; r < face_order.size(); ++r)
+      sorted_faces[r] = (*exported_faces)[face_order[r]];
+    exported_faces->swap(sorted_faces);
   }
+}
+
+void store_triangles(const std::vector<std::array<int, 3>> &triangles,
+                     LoopCGAL::IndexType index_type,
+                     LoopCGAL::FaceLayout layout, NumpyMesh &result) {
+  if (index_type == LoopCGAL::IndexType::Int64)
+    store_triangles<std::int64_t>(triangles, layout, result);
+  else
+    store_triangles<std::int32_t>(triangles, layout, result);
+}
+
+void store_triangles(const std::vector<std::array<int, 3>> &triangles,
+                     NumpyMesh &result) {
+  store_triangles(triangles, LoopCGAL::get_index_type(),
+                  LoopCGAL::get_face_layout(), result);
+}
 
-  if (LoopCGAL::verbose)
-    std::cout << "Kept " << triangles.size() << " triangles.\n";
+// —‑‑‑‑‑ 5.  Resample attributes onto the exported vertices/faces --------
+// vertex(i) is exported vertex i, corner(i, k) the index of corner k of
+// exported face i. Each connected component of the export samples the
+// input component most of its vertices lie on.
+template <typename VertexAt, typename CornerAt>
+void sample_attributes(std::size_t n_vertices, VertexAt vertex,
+                       std::size_t n_faces, CornerAt corner,
+                       const AttributeTransfer *attributes,
+                       NumpyMesh &result) {
+  if (!attributes || attributes->empty())
+    return;
+  const std::size_t nva = attributes->vertex_names().size();
+  const std::size_t nfa = attributes->face_names().size();
+  std::vector<pybind11::array_t<double>> vattr, fattr;
+  for (std::size_t a = 0; a < nva; ++a)
+    vattr.emplace_back(static_cast<ssize_t>(n_vertices));
+  for (std::size_t a = 0; a < nfa; ++a)
+    fattr.emplace_back(static_cast<ssize_t>(n_faces));
 
-  // —‑‑‑‑‑ 3.  Convert to NumPy arrays -----------------------------------
+  // Source component of every exported vertex, by majority over the
+  // vertices of its exported component
+  std::vector<std::size_t> source(n_vertices,
+                                  AttributeTransfer::any_component);
+  if (attributes->component_count() > 1) {
+    VertexSets sets(n_vertices);
+    for (std::size_t i = 0; i < n_faces; ++i) {
+      sets.unite(corner(i, 0), corner(i, 1));
+      sets.unite(corner(i, 0), corner(i, 2));
+    }
+    std::unordered_map<std::size_t, std::vector<std::size_t>> votes;
+    for (std::size_t i = 0; i < n_vertices; ++i) {
+      std::vector<std::size_t> &tally = votes[sets.find(i)];
+      tally.resize(attributes->component_count(), 0);
+      const std::size_t c = attributes->component_at(vertex(i));
+      if (c != AttributeTransfer::any_component)
+        ++tally[c];
+    }
+    for (std::size_t i = 0; i < n_vertices; ++i) {
+      const std::vector<std::size_t> &tally = votes[sets.find(i)];
+      source[i] = static_cast<std::size_t>(
+          std::max_element(tally.begin(), tally.end()) - tally.begin());
+    }
+  }
+
+  std::vector<double> sample(std::max(nva, nfa));
+  for (size_t i = 0; i < n_vertices && nva > 0; ++i) {
+    attributes->sample_vertex(vertex(i), source[i], sample.data());
+    for (std::size_t a = 0; a < nva; ++a)
+      vattr[a].mutable_at(i) = sample[a];
+  }
+  for (size_t i = 0; i < n_faces && nfa > 0; ++i) {
+    const Point centroid =
+        CGAL::centroid(vertex(corner(i, 0)), vertex(corner(i, 1)),
+                       vertex(corner(i, 2)));
+    attributes->sample_face(centroid, source[corner(i, 0)], sample.data());
+    for (std::size_t a = 0; a < nfa; ++a)
+      fattr[a].mutable_at(i) = sample[a];
+  }
+  for (std::size_t a = 0; a < nva; ++a)
+    result.vertex_attributes[attributes->vertex_names()[a]] = vattr[a];
+  for (std::size_t a = 0; a < nfa; ++a)
+    result.face_attributes[attributes->face_names()[a]] = fattr[a];
+}
+
+void sample_attributes(const ExportData &data,
+                       const AttributeTransfer *attributes,
+                       NumpyMesh &result) {
+  const std::vector<std::array<double, 3>> &vertices = data.vertices;
+  const std::vector<std::array<int, 3>> &triangles = data.triangles;
+  sample_attributes(
+      vertices.size(),
+      [&](std::size_t i) {
+        return Point(vertices[i][0], vertices[i][1], vertices[i][2]);
+      },
+      triangles.size(),
+      [&](std::size_t i, int k) {
+        return static_cast<std::size_t>(triangles[i][k]);
+      },
+      attributes, result);
+}
+
+// The same, for a compacted mesh exported as is: vertex and face i are
+// the slots i of tm.
+void sample_attributes(const TriangleMesh &tm,
+                       const AttributeTransfer *attributes,
+                       NumpyMesh &result) {
+  sample_attributes(
+      tm.number_of_vertices(),
+      [&](std::size_t i) {
+        return tm.point(TriangleMesh::Vertex_index(
+            static_cast<TriangleMesh::size_type>(i)));
+      },
+      tm.number_of_faces(),
+      [&](std::size_t i, int k) {
+        auto h = tm.halfedge(TriangleMesh::Face_index(
+            static_cast<TriangleMesh::size_type>(i)));
+        for (; k > 0; --k)
+          h = tm.next(h);
+        return static_cast<std::size_t>(tm.target(h));
+      },
+      attributes, result);
+}
+
+// —‑‑‑‑‑ 3./4.  Convert to NumPy arrays and package ----------------------
+NumpyMesh pack_export(const ExportData &data,
+                      const AttributeTransfer *attributes) {
+  const std::vector<std::array<double, 3>> &vertices = data.vertices;
   pybind11::array_t<double> vertices_array(
       {static_cast<int>(vertices.size()), 3});
   auto vbuf = vertices_array.mutable_unchecked<2>();
@@ -110,18 +538,126 @@ NumpyMesh export_mesh(const TriangleMesh &tm, double area_threshold,
     vbuf(i, 2) = vertices[i][2];
   }
 
-  pybind11::array_t<int> triangles_array(
-      {static_cast<int>(triangles.size()), 3});
-  auto tbuf = triangles_array.mutable_unchecked<2>();
-  for (size_t i = 0; i < triangles.size(); ++i) {
-    tbuf(i, 0) = triangles[i][0];
-    tbuf(i, 1) = triangles[i][1];
-    tbuf(i, 2) = triangles[i][2];
+  NumpyMesh result;
+  result.vertices = vertices_array;
+  store_triangles(data.triangles, result);
+  sample_attributes(data, attributes, result);
+  return result;
+}
+
+// Read-only (V, 3) view of the points of an exported mesh; the view keeps
+// the mesh alive.
+pybind11::array exported_vertices(
+    const std::shared_ptr<const ExportedMesh> &exported) {
+  static_assert(sizeof(Point) == 3 * sizeof(double),
+                "Point must be three packed doubles");
+  const TriangleMesh &tm = exported->mesh();
+  const ssize_t n = static_cast<ssize_t>(tm.number_of_vertices());
+  const double *data =
+      n > 0 ? reinterpret_cast<const double *>(
+                  &tm.point(TriangleMesh::Vertex_index(0)))
+            : nullptr;
+  pybind11::capsule owner(
+      new std::shared_ptr<const ExportedMesh>(exported), [](void *p) {
+        delete static_cast<std::shared_ptr<const ExportedMesh> *>(p);
+      });
+  pybind11::array view(pybind11::dtype::of<double>(), {n, ssize_t(3)},
+                       {ssize_t(sizeof(Point)), ssize_t(sizeof(double))},
+                       data, owner);
+  view.attr("setflags")(pybind11::arg("write") = false);
+  return view;
+}
+} // namespace
+
+const pybind11::array &ExportedMesh::triangles() const {
+  build();
+  return _triangles;
+}
+
+const pybind11::array &ExportedMesh::offsets() const {
+  build();
+  return _offsets;
+}
+
+void ExportedMesh::build() const {
+  if (_built)
+    return;
+  std::vector<std::array<int, 3>> triangles;
+  triangles.reserve(_mesh.number_of_faces());
+  for (auto f : _mesh.faces()) {
+    std::array<int, 3> tri;
+    int k = 0;
+    for (auto he : CGAL::halfedges_around_face(_mesh.halfedge(f), _mesh))
+      tri[k++] = static_cast<int>(CGAL::target(he, _mesh).idx());
+    triangles.push_back(tri);
   }
+  NumpyMesh packed;
+  store_triangles(triangles, _index_type, _face_layout, packed);
+  _triangles = packed.triangles;
+  _offsets = packed.offsets;
+  _built = true;
+}
+
+const pybind11::array &mesh_triangles(const NumpyMesh &mesh) {
+  return mesh.exported ? mesh.exported->triangles() : mesh.triangles;
+}
+
+const pybind11::array &mesh_offsets(const NumpyMesh &mesh) {
+  return mesh.exported ? mesh.exported->offsets() : mesh.offsets;
+}
 
-  // —‑‑‑‑‑ 4.  Package & return ------------------------------------------
+std::size_t mesh_triangle_count(const NumpyMesh &mesh) {
+  if (mesh.exported)
+    return mesh.exported->mesh().number_of_faces();
+  return static_cast<std::size_t>(
+      LoopCGAL::triangle_count(mesh.triangles, mesh.offsets));
+}
+
+void detach_exported(NumpyMesh &mesh) {
+  if (!mesh.exported)
+    return;
+  mesh.triangles = mesh.exported->triangles();
+  mesh.offsets = mesh.exported->offsets();
+  mesh.exported.reset();
+}
+
+NumpyMesh export_mesh(const TriangleMesh &tm, double area_threshold,
+                      double duplicate_vertex_threshold,
+                      const AttributeTransfer *attributes,
+                      std::vector<TriangleMesh::Face_index> *exported_faces) {
+  ExportData data = collect_export(tm, area_threshold,
+                                   duplicate_vertex_threshold, exported_faces);
+  if (LoopCGAL::get_spatial_ordering())
+    hilbert_reorder(data, exported_faces);
+  return pack_export(data, attributes);
+}
+
+NumpyMesh export_mesh(TriangleMesh &&tm, double area_threshold,
+                      double duplicate_vertex_threshold,
+                      const AttributeTransfer *attributes) {
+  if (!exports_unchanged(tm, area_threshold, duplicate_vertex_threshold))
+    return export_mesh(static_cast<const TriangleMesh &>(tm), area_threshold,
+                       duplicate_vertex_threshold, attributes);
   NumpyMesh result;
-  result.vertices = vertices_array;
-  result.triangles = triangles_array;
+  result.exported = std::make_shared<const ExportedMesh>(std::move(tm));
+  result.vertices = exported_vertices(result.exported);
+  sample_attributes(result.exported->mesh(), attributes, result);
+  LOOPCGAL_DEBUG("Exported mesh kept as a Surface_mesh; triangles are built "
+                 "on first access.");
   return result;
-}
\ No newline at end of file
+}
+
+CGAL::Bbox_3 mesh_bbox(const NumpyMesh &mesh) {
+  if (mesh.exported)
+    return PMP::bbox(mesh.exported->mesh());
+  CGAL::Bbox_3 box;
+  if (mesh.vertices.size() == 0)
+    return box;
+  LoopCGAL::visit_coordinates(mesh.vertices, [&](auto vertices) {
+    for (ssize_t i = 0; i < vertices.shape(0); ++i) {
+      const double x = vertices(i, 0), y = vertices(i, 1), z = vertices(i, 2);
+      box += CGAL::Bbox_3(x, y, z, x, y, z);
+    }
+  });
+  return box;
+}
@@ -1,10 +1,82 @@
 #ifndef MESHUTILS_H
 #define MESHUTILS_H
+#include "globals.h"
 #include "mesh.h"
 
 std::set<TriangleMesh::Edge_index> collect_border_edges(const TriangleMesh &tm);
+// Appends the vertex and triangle arrays to tm without copying them; an
+// empty offsets array selects the (n, 3) or padded layout. With
+// spatial_order the vertices and faces are added in Hilbert order instead
+// of row order.
+void load_arrays(TriangleMesh &tm, const pybind11::array &vertices,
+                 const pybind11::array &triangles,
+                 const pybind11::array &offsets, bool spatial_order = false);
+// Permutation listing the points in Hilbert curve order
+std::vector<std::size_t> hilbert_order(const std::vector<Point> &points);
+class AttributeTransfer;
 NumpyMesh export_mesh(const TriangleMesh &tm, double area_threshold,
-                      double duplicate_vertex_threshold);
+                      double duplicate_vertex_threshold,
+                      const AttributeTransfer *attributes = nullptr,
+                      std::vector<TriangleMesh::Face_index> *exported_faces =
+                          nullptr);
+// Takes over tm. When no face is dropped, no vertex merged and no spatial
+// ordering is requested, the result keeps tm as its ExportedMesh instead
+// of copying it into arrays; otherwise this is the export above.
+NumpyMesh export_mesh(TriangleMesh &&tm, double area_threshold,
+                      double duplicate_vertex_threshold,
+                      const AttributeTransfer *attributes = nullptr);
+
+// A compacted Surface_mesh held by an exported NumpyMesh. Its triangle
+// array is built once, on first access, in the index type and face layout
+// in effect when the mesh was exported.
+class ExportedMesh {
+public:
+  explicit ExportedMesh(TriangleMesh mesh)
+      : _mesh(std::move(mesh)), _index_type(LoopCGAL::get_index_type()),
+        _face_layout(LoopCGAL::get_face_layout()) {}
+  const TriangleMesh &mesh() const { return _mesh; }
+  const pybind11::array &triangles() const;
+  const pybind11::array &offsets() const;
+
+private:
+  void build() const;
+
+  TriangleMesh _mesh;
+  LoopCGAL::IndexType _index_type;
+  LoopCGAL::FaceLayout _face_layout;
+  mutable bool _built = false;
+  mutable pybind11::array _triangles;
+  mutable pybind11::array _offsets;
+};
+// Triangles / offsets of a mesh, built from its ExportedMesh if it has one
+const pybind11::array &mesh_triangles(const NumpyMesh &mesh);
+const pybind11::array &mesh_offsets(const NumpyMesh &mesh);
+std::size_t mesh_triangle_count(const NumpyMesh &mesh);
+CGAL::Bbox_3 mesh_bbox(const NumpyMesh &mesh);
+// Replaces the ExportedMesh by plain arrays, before the arrays are changed
+void detach_exported(NumpyMesh &mesh);
+// One list of polylines per plane / pair, packed into flat arrays
+typedef std::vector<std::vector<Point>> Polylines;
+NumpyPolylines export_polylines(const std::vector<Polylines> &groups);
+bool clean_degenerate_faces(TriangleMesh &tm,
+                            const std::set<TriangleMesh::Edge_index> &protected_edges);
+bool clean_degenerate_faces(TriangleMesh &tm, EdgeFlagMap protected_edges);
+void stitch_mesh(TriangleMesh &tm);
+// Per-iteration remeshing statistics used to detect convergence
+struct RemeshStats {
+  std::size_t n_vertices = 0;
+  std::size_t n_faces = 0;
+  std::size_t n_edges = 0;
+  std::size_t n_out_of_band = 0; // edges isotropic remeshing would split/collapse
+  double mean_edge_length = 0.0;
+  double std_edge_length = 0.0;
+};
+RemeshStats remesh_stats(const TriangleMesh &tm, double target_edge_length);
+// True when, from one iteration to the next, the vertex, face and
+// out-of-band edge counts and the edge-length mean and spread each changed
+// by less than tolerance, as a fraction of their current value (0.01 = 1%).
+bool remesh_converged(const RemeshStats &previous, const RemeshStats &current,
+                      double tolerance);
 double calculate_triangle_area(const std::array<double, 3> &v1,
                                const std::array<double, 3> &v2,
                                const std::array<double, 3> &v3);
@@ -1,9 +1,38 @@
 #ifndef NUMPYMESH_H
 #define NUMPYMESH_H
+#include <cstdint>
+#include <map>
+#include <memory>
 #include <pybind11/numpy.h>
+#include <string>
+class ExportedMesh;
 struct NumpyMesh {
+  // Arrays of any float / integer dtype, read in place on load; see
+  // arrayview.h. triangles is (n, 3), a padded VTK cell array, or VTK
+  // connectivity when offsets is non-empty. Exported meshes hold float64
+  // vertices and triangles in the index type and face layout of the
+  // exporting call.
+  pybind11::array vertices;
+  pybind11::array triangles;
+  pybind11::array offsets;
+  // Optional named scalar fields, one value per vertex / per triangle
+  std::map<std::string, pybind11::array_t<double>> vertex_attributes;
+  std::map<std::string, pybind11::array_t<double>> face_attributes;
+  // Set on meshes returned by the clip entry points and TriMesh.save when
+  // the result could be kept as is: vertices is then a read-only view of
+  // its points, triangles and offsets are built on first access (see
+  // mesh_triangles), and passing the mesh back in copies it instead of
+  // loading the arrays.
+  std::shared_ptr<const ExportedMesh> exported;
+};
+// Polylines packed as in VTK: polyline i runs through the rows
+// offsets[i] .. offsets[i + 1] - 1 of vertices, and ids[i] is the index of
+// the plane (or mesh pair) that produced it. Closed curves repeat their
+// first point at the end.
+struct NumpyPolylines {
   pybind11::array_t<double> vertices;
-  pybind11::array_t<int> triangles;
+  pybind11::array_t<std::int64_t> offsets;
+  pybind11::array_t<int> ids;
 };
 struct NumpyPlane {
   pybind11::array_t<double> normal; // Normal vector of the plane
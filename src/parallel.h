@@ -0,0 +1,88 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+#include "cancel.h"
+#include "globals.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace LoopCGAL
+{
+    // Runs f(i) for every i in [0, n) on up to num_threads() threads. Work
+    // items are handed out one at a time, so planes or pairs of very
+    // different cost balance themselves. The first exception thrown by f
+    // stops the remaining items and is rethrown on the calling thread.
+    // The caller's cancel token is checked before every item, on every
+    // thread, and its per-call log level applies on every thread. f must
+    // not touch Python objects: callers release the GIL around it.
+    template <typename F>
+    void parallel_for(std::size_t n, F &&f)
+    {
+        const std::size_t workers = std::min(n, num_threads());
+        if (workers <= 1)
+        {
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                check_cancelled();
+                f(i);
+            }
+            return;
+        }
+
+        std::atomic<std::size_t> next{0};
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+        std::mutex error_mutex;
+        CancelToken *token = current_cancel_token();
+        const int log_level = call_log_level();
+        auto work = [&]()
+        {
+            ScopedCancelToken cancel_scope(token);
+            ScopedCallLogLevel log_scope(log_level);
+            while (!failed.load(std::memory_order_relaxed))
+            {
+                const std::size_t i = next.fetch_add(1);
+                if (i >= n)
+                    return;
+                try
+                {
+                    check_cancelled();
+                    f(i);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(error_mutex);
+                    if (!error)
+                        error = std::current_exception();
+                    failed.store(true, std::memory_order_relaxed);
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(workers - 1);
+        for (std::size_t t = 1; t < workers; ++t)
+        {
+            try
+            {
+                threads.emplace_back(work);
+            }
+            catch (const std::system_error &)
+            {
+                break; // fewer threads than asked for; the rest still runs
+            }
+        }
+        work();
+        for (auto &thread : threads)
+            thread.join();
+        if (error)
+            std::rethrow_exception(error);
+    }
+}
+
+#endif // PARALLEL_H
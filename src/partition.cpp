@@ -0,0 +1,166 @@
+#include "partition.h"
+#include "aabb.h"
+#include "attributes.h"
+#include "cancel.h"
+#include "clip.h"
+#include "globals.h"
+#include "memory.h"
+#include "meshutils.h"
+#include <CGAL/Polygon_mesh_processing/bbox.h>
+#include <CGAL/Polygon_mesh_processing/connected_components.h>
+#include <CGAL/Polygon_mesh_processing/corefinement.h>
+#include <CGAL/Polygon_mesh_processing/intersection.h>
+#include <algorithm>
+#include <optional>
+
+namespace PMP = CGAL::Polygon_mesh_processing;
+
+namespace
+{
+  // Tests the clipper's triangles against the tree built once on the
+  // surface, stopping at the first hit.
+  bool touches_surface(const FaceTree &tree, const CGAL::Bbox_3 &surface_box,
+                       const TriangleMesh &clipper)
+  {
+    for (auto f : clipper.faces())
+    {
+      auto h = clipper.halfedge(f);
+      Triangle t(clipper.point(clipper.source(h)),
+                 clipper.point(clipper.target(h)),
+                 clipper.point(clipper.target(clipper.next(h))));
+      if (t.is_degenerate() || !CGAL::do_overlap(t.bbox(), surface_box))
+        continue;
+      if (tree.do_intersect(t))
+        return true;
+    }
+    return false;
+  }
+
+  // Joins clippers that neither cross nor touch one another, so each
+  // group can be corefined with the surface in a single pass. A joined
+  // mesh stays free of self-intersections, which corefine requires.
+  std::vector<TriangleMesh> group_clippers(std::vector<TriangleMesh> &cutting)
+  {
+    std::vector<CGAL::Bbox_3> boxes;
+    boxes.reserve(cutting.size());
+    for (const TriangleMesh &clipper : cutting)
+      boxes.push_back(PMP::bbox(clipper));
+
+    std::vector<std::vector<std::size_t>> members;
+    for (std::size_t i = 0; i < cutting.size(); ++i)
+    {
+      auto disjoint = [&](std::size_t j) {
+        return !CGAL::do_overlap(boxes[i], boxes[j]) ||
+               !PMP::do_intersect(cutting[i], cutting[j]);
+      };
+      auto group = std::find_if(
+          members.begin(), members.end(),
+          [&](const std::vector<std::size_t> &g) {
+            return std::all_of(g.begin(), g.end(), disjoint);
+          });
+      if (group == members.end())
+        members.emplace_back(1, i);
+      else
+        group->push_back(i);
+    }
+
+    std::vector<TriangleMesh> groups(members.size());
+    for (std::size_t g = 0; g < members.size(); ++g)
+      for (std::size_t i : members[g])
+        groups[g].join(cutting[i]);
+    return groups;
+  }
+} // namespace
+
+std::pair<NumpyMesh, pybind11::array_t<int>>
+partition_surface(NumpyMesh tm, std::vector<NumpyMesh> clippers,
+                  double target_edge_length, bool remesh_before_partition,
+                  double duplicate_vertex_threshold, double area_threshold,
+                  bool protect_constraints, bool relax_constraints,
+                  bool verbose)
+{
+  LoopCGAL::ScopedLogLevel log_scope(verbose);
+  LoopCGAL::MemoryCall memory("partition_surface");
+  memory.phase("load");
+  TriangleMesh _tm = load_mesh(tm, verbose);
+  AttributeTransfer attributes(tm);
+  PMP::remove_isolated_vertices(_tm);
+  MeshState tm_state;
+  validate_mesh(_tm, tm_state, ValidationStage::Input, "tm");
+  std::vector<TriangleMesh> loaded;
+  loaded.reserve(clippers.size());
+  for (const NumpyMesh &clipper : clippers)
+    loaded.push_back(load_mesh(clipper, verbose));
+
+  // The CGAL phases run without the GIL; checkpoints take it back only
+  // for the progress callback and signals.
+  std::optional<pybind11::gil_scoped_release> release(std::in_place);
+  if (remesh_before_partition)
+  {
+    memory.phase("remesh");
+    refine_mesh(_tm, true, verbose, target_edge_length, 3,
+                protect_constraints, relax_constraints);
+  }
+
+  // One tree on the surface serves every clipper; only clippers that
+  // actually touch the surface are corefined.
+  memory.phase("corefine");
+  std::vector<TriangleMesh> cutting;
+  {
+    FaceTree tree(faces(_tm).first, faces(_tm).second, _tm);
+    tree.build();
+    const CGAL::Bbox_3 surface_box = tree.bbox();
+    for (std::size_t i = 0; i < loaded.size(); ++i)
+    {
+      if (touches_surface(tree, surface_box, loaded[i]))
+        cutting.push_back(std::move(loaded[i]));
+      else
+        LOOPCGAL_DEBUG("Clipper " << i << " does not touch the surface.");
+    }
+  }
+  loaded.clear();
+  LOOPCGAL_DEBUG(cutting.size() << " of " << clippers.size()
+                                << " clippers intersect the surface.");
+  std::vector<TriangleMesh> groups = group_clippers(cutting);
+  cutting.clear();
+  LOOPCGAL_DEBUG("Corefining against " << groups.size()
+                                       << " group(s) of disjoint clippers.");
+
+  // Each corefinement inserts its intersection polylines into the surface
+  // and marks them constrained; earlier curves split by later ones keep
+  // their status. Only clippers that cross one another need more than
+  // one pass.
+  std::set<TriangleMesh::Edge_index> cut_edges;
+  auto ecm = CGAL::make_boolean_property_map(cut_edges);
+  LoopCGAL::CancelVisitor<PMP::Corefinement::Default_visitor<TriangleMesh>>
+      visitor;
+  for (std::size_t i = 0; i < groups.size(); ++i)
+  {
+    LoopCGAL::checkpoint("corefine", double(i) / groups.size());
+    PMP::corefine(_tm, groups[i],
+                  CGAL::parameters::edge_is_constrained_map(ecm).visitor(
+                      visitor));
+  }
+  memory.phase("export");
+  LoopCGAL::checkpoint("export");
+
+  auto fccmap =
+      _tm.add_property_map<TriangleMesh::Face_index, std::size_t>("f:block", 0)
+          .first;
+  const std::size_t n_blocks = PMP::connected_components(
+      _tm, fccmap, CGAL::parameters::edge_is_constrained_map(ecm));
+  LOOPCGAL_DEBUG("Partitioned surface into " << n_blocks << " blocks along "
+                                             << cut_edges.size()
+                                             << " intersection edges.");
+
+  release.reset();
+  std::vector<TriangleMesh::Face_index> exported_faces;
+  NumpyMesh result =
+      export_mesh(_tm, area_threshold, duplicate_vertex_threshold,
+                  &attributes, &exported_faces);
+  pybind11::array_t<int> labels(static_cast<ssize_t>(exported_faces.size()));
+  auto lbuf = labels.mutable_unchecked<1>();
+  for (std::size_t i = 0; i < exported_faces.size(); ++i)
+    lbuf(i) = static_cast<int>(fccmap[exported_faces[i]]);
+  return {result, labels};
+}
@@ -0,0 +1,23 @@
+#ifndef PARTITION_H
+#define PARTITION_H
+#include "numpymesh.h"
+#include <pybind11/numpy.h>
+#include <utility>
+#include <vector>
+
+// Corefine a surface against every clipper and label the faces
+// by the connected component (fault block) they fall in, using the
+// intersection curves and the surface border as component boundaries.
+// Clippers that do not touch one another are corefined together, so a set
+// of disjoint faults takes a single pass.
+// Returns the welded mesh and one block label per exported triangle.
+std::pair<NumpyMesh, pybind11::array_t<int>>
+partition_surface(NumpyMesh tm, std::vector<NumpyMesh> clippers,
+                  double target_edge_length = 10.0,
+                  bool remesh_before_partition = true,
+                  double duplicate_vertex_threshold = 1e-6,
+                  double area_threshold = 1e-6,
+                  bool protect_constraints = false,
+                  bool relax_constraints = true, bool verbose = false);
+
+#endif // PARTITION_H
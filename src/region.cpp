@@ -0,0 +1,217 @@
+#include "region.h"
+#include "globals.h"
+#include <CGAL/Polygon_mesh_processing/bbox.h>
+#include <CGAL/Polygon_mesh_processing/connected_components.h>
+#include <CGAL/Polygon_mesh_processing/measure.h>
+#include <CGAL/Polygon_mesh_processing/remesh.h>
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace PMP = CGAL::Polygon_mesh_processing;
+
+namespace
+{
+  typedef TriangleMesh::Vertex_index Vertex;
+  typedef TriangleMesh::Face_index Face;
+  typedef std::pair<Vertex, Vertex> VertexPair;
+
+  VertexPair ordered(Vertex a, Vertex b)
+  {
+    return a < b ? VertexPair(a, b) : VertexPair(b, a);
+  }
+
+  // Up to 8 rounds of splitting; each one only shrinks the roi
+  const int max_split_rounds = 8;
+
+  // Copies the triangles of tm selected by selected into part, adding
+  // each vertex once through to_part. False if a face cannot be added.
+  template <typename Selected, typename VertexMap>
+  bool copy_faces(const TriangleMesh &tm, Selected selected,
+                  VertexMap &to_part, TriangleMesh &part)
+  {
+    for (Face f : tm.faces())
+    {
+      if (!selected(f))
+        continue;
+      std::array<Vertex, 3> corners;
+      int k = 0;
+      for (Vertex v : vertices_around_face(tm.halfedge(f), tm))
+      {
+        if (k == 3)
+          return false;
+        if (to_part[v] == TriangleMesh::null_vertex())
+          to_part[v] = part.add_vertex(tm.point(v));
+        corners[k++] = to_part[v];
+      }
+      if (k != 3 ||
+          part.add_face(corners[0], corners[1], corners[2]) ==
+              TriangleMesh::null_face())
+        return false;
+    }
+    return true;
+  }
+} // namespace
+
+bool extract_region(TriangleMesh &tm, const CGAL::Bbox_3 &box,
+                    double max_seam_length, MeshRegion &region)
+{
+  auto in_roi = tm.add_property_map<Face, bool>("f:roi", false).first;
+  auto on_seam = [&](TriangleMesh::Halfedge_index h) {
+    const Face f = tm.face(h), g = tm.face(tm.opposite(h));
+    return f != TriangleMesh::null_face() && g != TriangleMesh::null_face() &&
+           in_roi[f] && !in_roi[g];
+  };
+
+  // Pieces of a split roi face may fall outside the box and leave new
+  // seam edges behind, so selection and splitting alternate.
+  std::size_t n_roi = 0;
+  for (int round = 0;; ++round)
+  {
+    n_roi = 0;
+    for (Face f : tm.faces())
+    {
+      in_roi[f] = CGAL::do_overlap(PMP::face_bbox(f, tm), box);
+      n_roi += in_roi[f];
+    }
+    if (max_seam_length <= 0.0)
+      break;
+    std::vector<TriangleMesh::Edge_index> long_edges;
+    for (auto h : tm.halfedges())
+      if (on_seam(h) && PMP::edge_length(h, tm) > max_seam_length)
+        long_edges.push_back(tm.edge(h));
+    if (long_edges.empty())
+      break;
+    if (round == max_split_rounds)
+    {
+      LOOPCGAL_DEBUG("Seam edges of the clip region did not converge.");
+      tm.remove_property_map(in_roi);
+      return false;
+    }
+    PMP::split_long_edges(long_edges, max_seam_length, tm);
+  }
+  if (n_roi == 0 || n_roi == tm.number_of_faces())
+  {
+    tm.remove_property_map(in_roi);
+    return false;
+  }
+
+  auto to_roi = tm.add_property_map<Vertex, Vertex>(
+                      "v:roi", TriangleMesh::null_vertex())
+                    .first;
+  auto to_rest = tm.add_property_map<Vertex, Vertex>(
+                       "v:rest", TriangleMesh::null_vertex())
+                     .first;
+  region.roi.clear();
+  region.rest.clear();
+  region.seam_edges.clear();
+  bool ok =
+      copy_faces(tm, [&](Face f) { return in_roi[f]; }, to_roi, region.roi) &&
+      copy_faces(tm, [&](Face f) { return !in_roi[f]; }, to_rest,
+                 region.rest);
+  if (ok)
+  {
+    region.seam = region.roi
+                      .add_property_map<Vertex, Vertex>(
+                          "v:seam", TriangleMesh::null_vertex())
+                      .first;
+    for (Vertex v : tm.vertices())
+      if (to_roi[v] != TriangleMesh::null_vertex() &&
+          to_rest[v] != TriangleMesh::null_vertex())
+        region.seam[to_roi[v]] = to_rest[v];
+    for (auto h : tm.halfedges())
+      if (on_seam(h))
+        region.seam_edges.insert(ordered(to_rest[tm.source(h)],
+                                         to_rest[tm.target(h)]));
+  }
+  tm.remove_property_map(to_rest);
+  tm.remove_property_map(to_roi);
+  tm.remove_property_map(in_roi);
+  return ok;
+}
+
+std::set<TriangleMesh::Edge_index> region_seam(const MeshRegion &region)
+{
+  const TriangleMesh &roi = region.roi;
+  std::set<TriangleMesh::Edge_index> seam;
+  for (auto h : roi.halfedges())
+  {
+    if (!roi.is_border(h))
+      continue;
+    const Vertex u = region.seam[roi.source(h)];
+    const Vertex v = region.seam[roi.target(h)];
+    if (u != TriangleMesh::null_vertex() && v != TriangleMesh::null_vertex() &&
+        region.seam_edges.count(ordered(u, v)))
+      seam.insert(roi.edge(h));
+  }
+  return seam;
+}
+
+bool merge_region(MeshRegion &region, DetachedComponents detached,
+                  TriangleMesh &out)
+{
+  TriangleMesh &roi = region.roi;
+  TriangleMesh &rest = region.rest;
+  out.clear();
+
+  // Seam edges that still have their roi face
+  std::set<VertexPair> kept;
+  for (auto e : region_seam(region))
+  {
+    const auto h = roi.halfedge(e);
+    kept.insert(ordered(region.seam[roi.source(h)],
+                        region.seam[roi.target(h)]));
+  }
+
+  auto component = rest.add_property_map<Face, std::size_t>("f:component", 0)
+                       .first;
+  const std::size_t n_components = PMP::connected_components(rest, component);
+  enum : unsigned char { Kept = 1, Removed = 2 };
+  std::vector<unsigned char> status(n_components, 0);
+  for (const VertexPair &edge : region.seam_edges)
+  {
+    auto h = rest.halfedge(edge.first, edge.second);
+    if (h == TriangleMesh::null_halfedge())
+      return false;
+    if (rest.is_border(h))
+      h = rest.opposite(h);
+    status[component[rest.face(h)]] |= kept.count(edge) ? Kept : Removed;
+  }
+  for (unsigned char s : status)
+    if (s == (Kept | Removed) ||
+        (s == 0 && detached == DetachedComponents::Fail))
+      return false;
+
+  auto rest_to_out = rest.add_property_map<Vertex, Vertex>(
+                            "v:out", TriangleMesh::null_vertex())
+                         .first;
+  if (!copy_faces(
+          rest,
+          [&](Face f) {
+            const unsigned char s = status[component[f]];
+            return s == Kept ||
+                   (s == 0 && detached == DetachedComponents::Keep);
+          },
+          rest_to_out, out))
+  {
+    out.clear();
+    return false;
+  }
+
+  // Seam vertices of the roi reuse the rest vertex they were cut from
+  auto roi_to_out = roi.add_property_map<Vertex, Vertex>(
+                           "v:out", TriangleMesh::null_vertex())
+                        .first;
+  for (Vertex v : roi.vertices())
+  {
+    const Vertex r = region.seam[v];
+    if (r != TriangleMesh::null_vertex())
+      roi_to_out[v] = rest_to_out[r];
+  }
+  const bool ok = copy_faces(
+      roi, [](Face) { return true; }, roi_to_out, out);
+  roi.remove_property_map(roi_to_out);
+  if (!ok)
+    out.clear();
+  return ok;
+}
@@ -0,0 +1,52 @@
+#ifndef REGION_H
+#define REGION_H
+#include "clip.h"
+#include <CGAL/Bbox_3.h>
+#include <set>
+#include <utility>
+
+// A mesh split into the faces near a clipper (roi) and all other faces
+// (rest), so that only the roi is remeshed and clipped. The seam between
+// the two keeps its vertices and edges and is welded again afterwards.
+struct MeshRegion
+{
+  typedef TriangleMesh::Vertex_index Vertex;
+
+  TriangleMesh roi;
+  TriangleMesh rest;
+  // The rest vertex of every roi vertex on the seam, null elsewhere
+  TriangleMesh::Property_map<Vertex, Vertex> seam;
+  // Seam edges as ordered pairs of rest vertices
+  std::set<std::pair<Vertex, Vertex>> seam_edges;
+};
+
+// Moves the faces of tm whose bbox overlaps box into region.roi and the
+// others into region.rest. With max_seam_length > 0 longer seam edges are
+// first split in tm, so the seam can be protected while the roi is
+// remeshed. Returns false when box covers none or all of tm.
+bool extract_region(TriangleMesh &tm, const CGAL::Bbox_3 &box,
+                    double max_seam_length, MeshRegion &region);
+
+// The roi edges that lie on the seam.
+std::set<TriangleMesh::Edge_index> region_seam(const MeshRegion &region);
+
+// What merge_region does with rest components that share no edge with the
+// roi: give up, drop them (outside a closed clipper) or keep them (nothing
+// was clipped).
+enum class DetachedComponents
+{
+  Fail,
+  Drop,
+  Keep
+};
+
+// Welds the processed roi back onto the rest. A rest component is kept if
+// the roi faces along its seam edges are still there, and dropped if they
+// were all clipped away; components that do not share an edge with the roi
+// are handled as detached says. Returns false, leaving out empty, when a
+// component borders both kept and removed roi faces, a detached component
+// meets DetachedComponents::Fail, or the faces cannot be welded.
+bool merge_region(MeshRegion &region, DetachedComponents detached,
+                  TriangleMesh &out);
+
+#endif // REGION_H
@@ -0,0 +1,207 @@
+#include "remeshcache.h"
+#include "arrayview.h"
+#include "globals.h"
+#include "meshutils.h"
+#include <cstring>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <unordered_map>
+
+namespace LoopCGAL
+{
+    namespace
+    {
+        // splitmix64 finaliser folded into a running hash
+        inline std::uint64_t mix(std::uint64_t h, std::uint64_t value)
+        {
+            value += 0x9E3779B97F4A7C15ull;
+            value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+            value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+            value ^= value >> 31;
+            return (h ^ value) * 0x100000001B3ull + (h >> 29);
+        }
+
+        inline std::uint64_t bits(double value)
+        {
+            std::uint64_t result;
+            std::memcpy(&result, &value, sizeof(result));
+            return result;
+        }
+
+        struct KeyHash
+        {
+            std::size_t operator()(const RemeshCacheKey &key) const noexcept
+            {
+                return static_cast<std::size_t>(key.hash);
+            }
+        };
+
+        // Rough footprint of a compacted Surface_mesh: points and vertex
+        // connectivity, halfedge connectivity, face connectivity and the
+        // removed flags.
+        std::size_t mesh_bytes(const TriangleMesh &tm)
+        {
+            return tm.number_of_vertices() * (sizeof(Point) + 5) +
+                   tm.number_of_halfedges() * 12 + tm.number_of_edges() +
+                   tm.number_of_faces() * 5;
+        }
+
+        struct Entry
+        {
+            RemeshCacheKey key;
+            std::shared_ptr<const TriangleMesh> mesh;
+            std::size_t bytes; // mesh and key values
+        };
+
+        struct Cache
+        {
+            std::mutex mutex;
+            std::list<Entry> lru; // most recently used first
+            std::unordered_map<RemeshCacheKey, std::list<Entry>::iterator,
+                               KeyHash>
+                index;
+            RemeshCacheStats stats;
+
+            void evict_to(std::size_t budget)
+            {
+                while (!lru.empty() && stats.bytes > budget)
+                {
+                    stats.bytes -= lru.back().bytes;
+                    index.erase(lru.back().key);
+                    lru.pop_back();
+                }
+                stats.entries = lru.size();
+            }
+        };
+
+        Cache &cache()
+        {
+            static Cache instance;
+            return instance;
+        }
+    } // namespace
+
+    void set_remesh_cache_budget(std::size_t bytes)
+    {
+        Cache &c = cache();
+        std::lock_guard<std::mutex> lock(c.mutex);
+        c.stats.budget = bytes;
+        c.evict_to(bytes);
+    }
+
+    bool remesh_cache_enabled()
+    {
+        Cache &c = cache();
+        std::lock_guard<std::mutex> lock(c.mutex);
+        return c.stats.budget > 0;
+    }
+
+    void clear_remesh_cache()
+    {
+        Cache &c = cache();
+        std::lock_guard<std::mutex> lock(c.mutex);
+        c.evict_to(0);
+        c.stats.hits = c.stats.misses = 0;
+    }
+
+    RemeshCacheStats remesh_cache_stats()
+    {
+        Cache &c = cache();
+        std::lock_guard<std::mutex> lock(c.mutex);
+        return c.stats;
+    }
+
+    RemeshCacheKey remesh_cache_key(const NumpyMesh &mesh,
+                                    std::initializer_list<double> parameters)
+    {
+        RemeshCacheKey key;
+        auto values = std::make_shared<std::vector<std::uint64_t>>();
+        std::uint64_t h = 0xCBF29CE484222325ull;
+        auto add = [&](std::uint64_t value) {
+            values->push_back(value);
+            h = mix(h, value);
+        };
+        for (double parameter : parameters)
+            add(bits(parameter));
+        visit_coordinates(mesh.vertices, [&](auto vertices) {
+            key.n_vertices = static_cast<std::size_t>(vertices.shape(0));
+            values->reserve(values->size() + 3 * key.n_vertices);
+            for (ssize_t i = 0; i < vertices.shape(0); ++i)
+                for (ssize_t k = 0; k < 3; ++k)
+                    add(bits(static_cast<double>(vertices(i, k))));
+        });
+        if (mesh.exported)
+        {
+            // Same corners as its triangle array, without building it
+            const TriangleMesh &tm = mesh.exported->mesh();
+            key.n_triangles = tm.number_of_faces();
+            values->reserve(values->size() + 3 * key.n_triangles);
+            for (auto f : tm.faces())
+                for (auto v : vertices_around_face(tm.halfedge(f), tm))
+                    add(static_cast<std::uint64_t>(v.idx()));
+        }
+        else
+            visit_triangles(mesh.triangles, mesh.offsets, [&](auto triangles) {
+                key.n_triangles = static_cast<std::size_t>(triangles.size());
+                values->reserve(values->size() + 3 * key.n_triangles);
+                for (ssize_t i = 0; i < triangles.size(); ++i)
+                    for (int k = 0; k < 3; ++k)
+                        add(static_cast<std::uint64_t>(triangles(i, k)));
+            });
+        key.hash = h;
+        key.values = std::move(values);
+        return key;
+    }
+
+    bool remesh_cache_lookup(const RemeshCacheKey &key, TriangleMesh &out)
+    {
+        std::shared_ptr<const TriangleMesh> mesh;
+        {
+            Cache &c = cache();
+            std::lock_guard<std::mutex> lock(c.mutex);
+            auto it = c.index.find(key);
+            if (it == c.index.end())
+            {
+                ++c.stats.misses;
+                return false;
+            }
+            c.lru.splice(c.lru.begin(), c.lru, it->second);
+            mesh = it->second->mesh;
+            ++c.stats.hits;
+        }
+        out = *mesh; // copied outside the lock
+        return true;
+    }
+
+    void remesh_cache_store(const RemeshCacheKey &key, const TriangleMesh &mesh)
+    {
+        auto copy = std::make_shared<TriangleMesh>(mesh);
+        copy->collect_garbage();
+        const std::size_t bytes =
+            mesh_bytes(*copy) +
+            (key.values ? key.values->size() * sizeof(std::uint64_t) : 0);
+
+        Cache &c = cache();
+        std::lock_guard<std::mutex> lock(c.mutex);
+        if (bytes > c.stats.budget)
+        {
+            LOOPCGAL_DEBUG("Remeshed surface of " << bytes
+                                                  << " bytes exceeds the "
+                                                     "cache budget.");
+            return;
+        }
+        auto it = c.index.find(key);
+        if (it != c.index.end())
+        {
+            c.stats.bytes -= it->second->bytes;
+            c.lru.erase(it->second);
+            c.index.erase(it);
+        }
+        c.lru.push_front(Entry{key, std::move(copy), bytes});
+        c.index[key] = c.lru.begin();
+        c.stats.bytes += bytes;
+        c.evict_to(c.stats.budget);
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef REMESHCACHE_H
+#define REMESHCACHE_H
+#include "numpymesh.h"
+#include <CGAL/Simple_cartesian.h>
+#include <CGAL/Surface_mesh.h>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+typedef CGAL::Simple_cartesian<double> Kernel;
+typedef Kernel::Point_3 Point;
+typedef CGAL::Surface_mesh<Point> TriangleMesh;
+
+namespace LoopCGAL
+{
+    // LRU cache of input surfaces after the pre-clip remesh, keyed by the
+    // content of the vertex / triangle buffers and the remesh parameters,
+    // so clipping one horizon by many faults remeshes it once. Disabled
+    // (budget 0) by default; the budget bounds the estimated memory of the
+    // cached meshes. Only geometry is cached: attributes are resampled
+    // from the input arrays at export.
+    void set_remesh_cache_budget(std::size_t bytes);
+    bool remesh_cache_enabled();
+    void clear_remesh_cache();
+
+    struct RemeshCacheStats
+    {
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+        std::size_t entries = 0;
+        std::size_t bytes = 0;
+        std::size_t budget = 0;
+    };
+    RemeshCacheStats remesh_cache_stats();
+
+    struct RemeshCacheKey
+    {
+        std::uint64_t hash = 0;
+        std::size_t n_vertices = 0;
+        std::size_t n_triangles = 0;
+        // Every hashed value, compared on a hit so that a hash collision
+        // never hands back another surface. Shared by the cache entry and
+        // its index.
+        std::shared_ptr<const std::vector<std::uint64_t>> values;
+        bool operator==(const RemeshCacheKey &other) const
+        {
+            return hash == other.hash && n_vertices == other.n_vertices &&
+                   n_triangles == other.n_triangles &&
+                   (values == other.values ||
+                    (values && other.values && *values == *other.values));
+        }
+    };
+    // Hashes the values (not the bytes) of the arrays, in place, so the
+    // same surface gives the same key whatever its dtype or layout. Cheap
+    // next to loading the mesh, so callers look up before load_mesh.
+    RemeshCacheKey remesh_cache_key(const NumpyMesh &mesh,
+                                    std::initializer_list<double> parameters);
+    // Copies the cached mesh into out and returns true on a hit
+    bool remesh_cache_lookup(const RemeshCacheKey &key, TriangleMesh &out);
+    void remesh_cache_store(const RemeshCacheKey &key, const TriangleMesh &mesh);
+}
+
+#endif // REMESHCACHE_H
@@ -0,0 +1,46 @@
+#include "slice.h"
+#include "aabb.h"
+#include "clip.h"
+#include "globals.h"
+#include "meshstate.h"
+#include "meshutils.h"
+#include "parallel.h"
+#include <CGAL/Polygon_mesh_slicer.h>
+#include <pybind11/pybind11.h>
+#include <iterator>
+
+typedef CGAL::Polygon_mesh_slicer<
+    TriangleMesh, Kernel,
+    boost::property_map<TriangleMesh, CGAL::vertex_point_t>::type, EdgeTree>
+    Slicer;
+
+NumpyPolylines slice_planes(NumpyMesh tm, std::vector<NumpyPlane> planes,
+                            bool verbose)
+{
+  LoopCGAL::ScopedLogLevel log_scope(verbose);
+  TriangleMesh _tm = load_mesh(tm, verbose);
+  MeshState tm_state;
+  validate_mesh(_tm, tm_state, ValidationStage::Input, "tm");
+
+  std::vector<Plane> cuts;
+  cuts.reserve(planes.size());
+  for (const NumpyPlane &plane : planes)
+    cuts.push_back(load_plane(plane, verbose));
+
+  std::vector<Polylines> sections(cuts.size());
+  if (!_tm.is_empty() && !cuts.empty())
+  {
+    pybind11::gil_scoped_release release;
+    EdgeTree tree(edges(_tm).first, edges(_tm).second, _tm);
+    tree.build();
+    LoopCGAL::parallel_for(cuts.size(), [&](std::size_t i) {
+      // The slicer only references the mesh and the tree; one per plane
+      // keeps its scratch state private to the thread.
+      Slicer slicer(_tm, tree);
+      slicer(cuts[i], std::back_inserter(sections[i]));
+    });
+  }
+  LOOPCGAL_DEBUG("Sliced " << _tm.number_of_faces() << " faces with "
+                           << cuts.size() << " planes.");
+  return export_polylines(sections);
+}
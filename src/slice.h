@@ -0,0 +1,13 @@
+#ifndef SLICE_H
+#define SLICE_H
+#include "numpymesh.h"
+#include <vector>
+
+// Cross-sections of a surface by many planes. One AABB tree over the mesh
+// edges is built and shared; the planes are intersected in parallel with
+// the GIL released. Nothing is clipped, remeshed or exported as a mesh.
+// Polyline ids are indices into planes.
+NumpyPolylines slice_planes(NumpyMesh tm, std::vector<NumpyPlane> planes,
+                            bool verbose = false);
+
+#endif // SLICE_H
@@ -0,0 +1,131 @@
+from __future__ import annotations
+
+import numpy as np
+import pytest
+
+import loop_cgal
+
+
+def _sheet(origin, u, v, nu, nv):
+    """Triangulated parallelogram origin + i / nu * u + j / nv * v."""
+    origin, u, v = (np.asarray(a, dtype=np.float64) for a in (origin, u, v))
+    i, j = np.meshgrid(np.arange(nu + 1), np.arange(nv + 1), indexing="ij")
+    vertices = (
+        origin
+        + (i.reshape(-1, 1) / nu) * u
+        + (j.reshape(-1, 1) / nv) * v
+    )
+    index = np.arange((nu + 1) * (nv + 1)).reshape(nu + 1, nv + 1)
+    a = index[:-1, :-1].ravel()
+    b = index[1:, :-1].ravel()
+    c = index[1:, 1:].ravel()
+    d = index[:-1, 1:].ravel()
+    triangles = np.concatenate(
+        [np.stack([a, b, c], axis=1), np.stack([a, c, d], axis=1)]
+    )
+    return vertices, triangles.astype(np.int64)
+
+
+def numpy_mesh(vertices, triangles, offsets=None) -> loop_cgal.NumpyMesh:
+    mesh = loop_cgal.NumpyMesh()
+    mesh.vertices = vertices
+    mesh.triangles = triangles
+    if offsets is not None:
+        mesh.offsets = offsets
+    return mesh
+
+
+def canonical(triangles) -> np.ndarray:
+    """(n, 3) triangles rotated to start at their smallest corner."""
+    rows = np.asarray(triangles).reshape(-1, 3)
+    first = np.argmin(rows, axis=1)
+    return np.array([np.roll(row, -k) for row, k in zip(rows, first)])
+
+
+@pytest.fixture
+def flat_grid():
+    """The square [0, 100]^2 at z = 0, facing +z, in 10 x 10 cells."""
+    return _sheet([0, 0, 0], [100, 0, 0], [0, 100, 0], 10, 10)
+
+
+@pytest.fixture
+def wall():
+    """Factory of vertical sheets x = x0 (or y = y0) across flat_grid."""
+
+    def make(x0=None, y0=None):
+        # No wall vertex or edge meets a grid vertex, edge or the plane z = 0
+        if x0 is not None:
+            return _sheet([x0, -7, -10], [0, 123, 0], [0, 0, 20], 4, 3)
+        return _sheet([-7, y0, -10], [123, 0, 0], [0, 0, 20], 4, 3)
+
+    return make
+
+
+@pytest.fixture
+def roof():
+    """The ridge z = -3 |x| over [-10, 10] x [0, 20], facing up."""
+    vertices, triangles = _sheet([-10, 0, 0], [20, 0, 0], [0, 20, 0], 10, 10)
+    vertices[:, 2] = -3.0 * np.abs(vertices[:, 0])
+    return vertices, triangles
+
+
+@pytest.fixture
+def tube():
+    """flat_grid closed into a flattened tube along y: its top at z = 30
+    joins the grid along x = 0 and x = 100, in 10 x 10 cells."""
+    loop = (
+        [(x, 0.0) for x in range(0, 101, 10)]
+        + [(100.0, 10.0), (100.0, 20.0)]
+        + [(x, 30.0) for x in range(100, -1, -10)]
+        + [(0.0, 20.0), (0.0, 10.0)]
+    )
+    n_loop, n_y = len(loop), 11
+    vertices = np.array(
+        [(x, 10.0 * j, z) for x, z in loop for j in range(n_y)], dtype=np.float64
+    )
+    i, j = np.meshgrid(np.arange(n_loop), np.arange(n_y - 1), indexing="ij")
+    i, j = i.ravel(), j.ravel()
+    a = i * n_y + j
+    b = ((i + 1) % n_loop) * n_y + j
+    triangles = np.concatenate(
+        [np.stack([a, b, b + 1], axis=1), np.stack([a, b + 1, a + 1], axis=1)]
+    )
+    return vertices, triangles.astype(np.int64)
+
+
+@pytest.fixture
+def box():
+    """Factory of closed boxes [x0, x1] x [y0, y1] x [z0, z1], facing out."""
+
+    def make(x0, x1, y0, y1, z0, z1):
+        # Corner k has bit 0 for x, bit 1 for y and bit 2 for z
+        vertices = np.array(
+            [
+                (x1 if k & 1 else x0, y1 if k & 2 else y0, z1 if k & 4 else z0)
+                for k in range(8)
+            ],
+            dtype=np.float64,
+        )
+        triangles = np.array(
+            [
+                [0, 2, 3], [0, 3, 1],  # z0
+                [4, 5, 7], [4, 7, 6],  # z1
+                [0, 1, 5], [0, 5, 4],  # y0
+                [2, 6, 7], [2, 7, 3],  # y1
+                [0, 4, 6], [0, 6, 2],  # x0
+                [1, 3, 7], [1, 7, 5],  # x1
+            ],
+            dtype=np.int64,
+        )
+        return vertices, triangles
+
+    return make
+
+
+@pytest.fixture
+def remesh_cache():
+    loop_cgal.clear_remesh_cache()
+    loop_cgal.set_remesh_cache_budget(1 << 28)
+    yield
+    loop_cgal.set_remesh_cache_budget(0)
+    loop_cgal.clear_remesh_cache()
@@ -0,0 +1,80 @@
+from __future__ import annotations
+
+import numpy as np
+from conftest import numpy_mesh
+
+import loop_cgal
+
+# Height of the second sheet over flat_grid, far below the remeshing target
+_GAP = 1e-3
+
+
+def _height(vertices) -> np.ndarray:
+    return vertices[:, 0] + 2.0 * vertices[:, 1]
+
+
+def _clip(mesh, clipper, **kwargs):
+    return loop_cgal.clip_surface(
+        mesh, numpy_mesh(*clipper), target_edge_length=4.0, **kwargs
+    )
+
+
+def test_attributes_follow_a_clip_and_remesh(flat_grid, wall):
+    vertices, triangles = flat_grid
+    mesh = numpy_mesh(vertices, triangles)
+    mesh.vertex_attributes = {"height": _height(vertices)}
+    mesh.face_attributes = {"row": np.arange(len(triangles), dtype=np.float64)}
+
+    result = _clip(mesh, wall(x0=45.0))
+
+    out = np.asarray(result.vertices)
+    height = np.asarray(result.vertex_attributes["height"])
+    row = np.asarray(result.face_attributes["row"])
+    assert len(out) != len(vertices)
+    assert height.shape == (len(out),) and row.shape == (result.n_triangles,)
+    # A linear field is reproduced exactly at split and moved vertices
+    np.testing.assert_allclose(height, _height(out), atol=1e-9)
+    assert set(row.tolist()) <= set(range(len(triangles)))
+
+
+def test_attributes_follow_a_plane_clip(flat_grid):
+    vertices, triangles = flat_grid
+    mesh = numpy_mesh(vertices, triangles)
+    mesh.vertex_attributes = {"height": _height(vertices)}
+
+    plane = loop_cgal.NumpyPlane()
+    plane.normal = np.array([1.0, 0.0, 0.0])
+    plane.origin = np.array([45.0, 0.0, 0.0])
+
+    result = loop_cgal.clip_plane(mesh, plane, target_edge_length=4.0)
+
+    out = np.asarray(result.vertices)
+    np.testing.assert_allclose(
+        result.vertex_attributes["height"], _height(out), atol=1e-9
+    )
+
+
+def test_close_parallel_sheets_keep_their_own_values(flat_grid, wall):
+    vertices, triangles = flat_grid
+    upper = vertices + np.array([0.0, 0.0, _GAP])
+    mesh = numpy_mesh(
+        np.vstack([vertices, upper]),
+        np.vstack([triangles, triangles + len(vertices)]),
+    )
+    mesh.vertex_attributes = {
+        "sheet": np.repeat([0.0, 1.0], len(vertices))
+    }
+    mesh.face_attributes = {"sheet": np.repeat([0.0, 1.0], len(triangles))}
+
+    result = _clip(mesh, wall(x0=45.0))
+
+    out = np.asarray(result.vertices)
+    faces = np.asarray(result.triangles).reshape(-1, 3)
+    on_upper = out[:, 2] > 0.5 * _GAP
+    assert on_upper.any() and not on_upper.all()
+    np.testing.assert_array_equal(
+        result.vertex_attributes["sheet"], on_upper.astype(np.float64)
+    )
+    np.testing.assert_array_equal(
+        result.face_attributes["sheet"], on_upper[faces[:, 0]].astype(np.float64)
+    )
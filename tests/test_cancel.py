@@ -0,0 +1,78 @@
+from __future__ import annotations
+
+import pytest
+from conftest import numpy_mesh
+
+import loop_cgal
+
+
+def _clip(flat_grid, wall, token):
+    return loop_cgal.clip_surface(
+        numpy_mesh(*flat_grid),
+        numpy_mesh(*wall(x0=45.0)),
+        target_edge_length=5.0,
+        token=token,
+    )
+
+
+def test_callback_returning_false_cancels(flat_grid, wall):
+    stages = []
+
+    def progress(stage, fraction):
+        stages.append((stage, fraction))
+        return False
+
+    token = loop_cgal.CancelToken(progress)
+    with pytest.raises(loop_cgal.CancelledError):
+        _clip(flat_grid, wall, token)
+    assert token.cancelled
+    assert stages == [("load", 1.0)]
+
+
+def test_cancelled_token_stops_the_call(flat_grid, wall):
+    token = loop_cgal.CancelToken()
+    token.cancel()
+
+    with pytest.raises(loop_cgal.CancelledError):
+        _clip(flat_grid, wall, token)
+
+    token.reset()
+    assert _clip(flat_grid, wall, token).n_triangles > 0
+
+
+def test_progress_callback_sees_the_phases(flat_grid, wall):
+    stages = []
+    token = loop_cgal.CancelToken(lambda stage, _: stages.append(stage))
+
+    result = _clip(flat_grid, wall, token)
+
+    assert result.n_triangles > 0
+    assert not token.cancelled
+    assert {"load", "clip", "export"} <= set(stages)
+
+
+def test_trimesh_methods_take_a_token(flat_grid, wall):
+    stages = []
+    token = loop_cgal.CancelToken(lambda stage, _: stages.append(stage))
+
+    mesh = loop_cgal.TriMesh(numpy_mesh(*flat_grid), token=token)
+    mesh.stitch(token=token)
+    mesh.remove_degenerate_faces(token=token)
+    mesh.signed_distance([[0.0, 0.0, 1.0]], token=token)
+    mesh.save(token=token)
+
+    assert {"load", "stitch", "cleanup", "export"} <= set(stages)
+
+
+def test_cancelled_token_stops_a_trimesh_cut(flat_grid, wall):
+    mesh = loop_cgal.TriMesh(numpy_mesh(*flat_grid))
+    clipper = loop_cgal.TriMesh(numpy_mesh(*wall(x0=45.0)))
+    n_before = mesh.save().n_triangles
+    token = loop_cgal.CancelToken()
+    token.cancel()
+
+    with pytest.raises(loop_cgal.CancelledError):
+        mesh.cut_with_surface(clipper, token=token)
+    with pytest.raises(loop_cgal.CancelledError):
+        mesh.stitch(token=token)
+    assert mesh.save().n_triangles == n_before
@@ -0,0 +1,75 @@
+from __future__ import annotations
+
+import numpy as np
+from conftest import canonical, numpy_mesh
+
+import loop_cgal
+
+# A zero-area triangle away from the grid: exporting it drops the face, which
+# forces the eager export; without it the result is kept as a Surface_mesh.
+_SLIVER = np.array([[200.0, 0.0, 0.0], [201.0, 0.0, 0.0], [202.0, 0.0, 0.0]])
+
+
+def _with_attributes(vertices, triangles):
+    mesh = numpy_mesh(vertices, triangles)
+    mesh.vertex_attributes = {"height": vertices[:, 0] + 2.0 * vertices[:, 1]}
+    mesh.face_attributes = {"row": np.arange(len(triangles), dtype=np.float64)}
+    return mesh
+
+
+def _export(mesh, far_wall, **kwargs):
+    # The clipper misses the surface, so the input is exported as it is
+    return loop_cgal.clip_surface(
+        mesh,
+        numpy_mesh(*far_wall),
+        remesh_before_clipping=False,
+        remesh_after_clipping=False,
+        remove_degenerate_faces=False,
+        **kwargs,
+    )
+
+
+def test_lazy_export_matches_eager_export(flat_grid, wall):
+    vertices, triangles = flat_grid
+    far_wall = wall(x0=1000.0)
+    n_vertices, n_triangles = len(vertices), len(triangles)
+    with_sliver = np.vstack([vertices, _SLIVER])
+    sliver_triangles = np.vstack([triangles, [[n_vertices, n_vertices + 1, n_vertices + 2]]])
+
+    lazy = _export(_with_attributes(vertices, triangles), far_wall)
+    eager = _export(_with_attributes(with_sliver, sliver_triangles), far_wall)
+
+    # Only the lazy result is a read-only view of the kept mesh
+    assert not lazy.vertices.flags.writeable
+    assert eager.vertices.flags.writeable
+    assert lazy.n_triangles == eager.n_triangles == n_triangles
+    np.testing.assert_array_equal(lazy.vertices, np.asarray(eager.vertices)[:n_vertices])
+    np.testing.assert_array_equal(canonical(lazy.triangles), canonical(eager.triangles))
+    for name in ("height",):
+        np.testing.assert_allclose(
+            lazy.vertex_attributes[name], eager.vertex_attributes[name][:n_vertices]
+        )
+    np.testing.assert_allclose(lazy.face_attributes["row"], eager.face_attributes["row"])
+
+
+def test_lazy_export_keeps_the_format_of_its_call(flat_grid, wall):
+    vertices, triangles = flat_grid
+    default = loop_cgal.get_face_layout()
+
+    lazy = _export(
+        numpy_mesh(vertices, triangles),
+        wall(x0=1000.0),
+        index_type=loop_cgal.IndexType.INT64,
+        face_layout=loop_cgal.FaceLayout.OFFSETS,
+    )
+    # Changing the module default before the triangles are first built
+    loop_cgal.set_face_layout(loop_cgal.FaceLayout.PADDED)
+    try:
+        faces = np.asarray(lazy.triangles)
+        offsets = np.asarray(lazy.offsets)
+    finally:
+        loop_cgal.set_face_layout(default)
+
+    assert faces.dtype == np.int64
+    assert faces.shape == (3 * len(triangles),)
+    np.testing.assert_array_equal(offsets, np.arange(0, 3 * len(triangles) + 1, 3))
@@ -0,0 +1,96 @@
+from __future__ import annotations
+
+import threading
+
+import numpy as np
+import pytest
+from conftest import canonical
+
+import loop_cgal
+
+
+def _layouts(triangles):
+    n = len(triangles)
+    padded = np.hstack([np.full((n, 1), 3, dtype=triangles.dtype), triangles])
+    return {
+        "rows": (triangles, None),
+        "padded": (padded.ravel(), None),
+        "column_slice": (padded[:, 1:], None),
+        "offsets": (triangles.ravel(), np.arange(0, 3 * n + 1, 3)),
+    }
+
+
+@pytest.mark.parametrize("vertex_dtype", [np.float32, np.float64])
+@pytest.mark.parametrize("index_dtype", [np.int32, np.int64, np.uint32])
+@pytest.mark.parametrize("layout", ["rows", "padded", "column_slice", "offsets"])
+def test_ingest_dtypes_and_layouts(flat_grid, vertex_dtype, index_dtype, layout):
+    vertices, triangles = flat_grid
+    faces, offsets = _layouts(triangles.astype(index_dtype))[layout]
+
+    mesh = loop_cgal.TriMesh(vertices.astype(vertex_dtype), faces, offsets)
+    result = mesh.save()
+
+    np.testing.assert_allclose(
+        result.vertices, vertices.astype(vertex_dtype).astype(np.float64)
+    )
+    np.testing.assert_array_equal(canonical(result.triangles), canonical(triangles))
+
+
+@pytest.mark.parametrize(
+    ("index_type", "dtype"),
+    [(loop_cgal.IndexType.INT32, np.int32), (loop_cgal.IndexType.INT64, np.int64)],
+)
+@pytest.mark.parametrize(
+    "face_layout",
+    [loop_cgal.FaceLayout.ROWS, loop_cgal.FaceLayout.PADDED, loop_cgal.FaceLayout.OFFSETS],
+)
+def test_per_call_export_format(flat_grid, index_type, dtype, face_layout):
+    vertices, triangles = flat_grid
+    default = (loop_cgal.get_index_type(), loop_cgal.get_face_layout())
+    mesh = loop_cgal.TriMesh(vertices, triangles)
+
+    result = mesh.save(index_type=index_type, face_layout=face_layout)
+
+    assert (loop_cgal.get_index_type(), loop_cgal.get_face_layout()) == default
+    faces = np.asarray(result.triangles)
+    offsets = np.asarray(result.offsets)
+    assert faces.dtype == dtype
+    n = len(triangles)
+    if face_layout == loop_cgal.FaceLayout.ROWS:
+        assert faces.shape == (n, 3)
+        assert offsets.size == 0
+    elif face_layout == loop_cgal.FaceLayout.PADDED:
+        assert faces.shape == (4 * n,)
+        assert (faces[::4] == 3).all()
+        assert offsets.size == 0
+    else:
+        assert faces.shape == (3 * n,)
+        assert offsets.dtype == dtype
+        np.testing.assert_array_equal(offsets, np.arange(0, 3 * n + 1, 3))
+    np.testing.assert_array_equal(
+        canonical(faces.reshape(n, -1)[:, -3:]), canonical(triangles)
+    )
+
+
+def test_export_format_is_per_thread(flat_grid):
+    vertices, triangles = flat_grid
+    mesh = loop_cgal.TriMesh(vertices, triangles)
+    errors = []
+
+    def run(index_type, dtype):
+        try:
+            for _ in range(20):
+                result = mesh.save(index_type=index_type)
+                assert np.asarray(result.triangles).dtype == dtype
+        except AssertionError as error:  # reported by the main thread
+            errors.append(error)
+
+    threads = [
+        threading.Thread(target=run, args=(loop_cgal.IndexType.INT32, np.int32)),
+        threading.Thread(target=run, args=(loop_cgal.IndexType.INT64, np.int64)),
+    ]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    assert not errors
@@ -0,0 +1,61 @@
+from __future__ import annotations
+
+import numpy as np
+import pytest
+from conftest import numpy_mesh
+
+import loop_cgal
+
+
+def _rows(lines):
+    """Points of the polylines and the id of the polyline of each point."""
+    points = np.asarray(lines.vertices)
+    offsets = np.asarray(lines.offsets)
+    ids = np.asarray(lines.ids)
+    assert offsets[0] == 0 and offsets[-1] == len(points)
+    assert len(ids) == len(offsets) - 1
+    return points, np.repeat(ids, np.diff(offsets))
+
+
+def test_intersection_curve_of_two_surfaces(flat_grid, wall):
+    lines = loop_cgal.intersection_curves(
+        numpy_mesh(*flat_grid), numpy_mesh(*wall(x0=45.0))
+    )
+
+    points, ids = _rows(lines)
+    assert len(points) > 0 and set(ids.tolist()) == {0}
+    # The line x = 45 across the grid
+    np.testing.assert_allclose(points[:, 0], 45.0, atol=1e-9)
+    np.testing.assert_allclose(points[:, 2], 0.0, atol=1e-9)
+    assert np.isclose(points[:, 1].min(), 0.0, atol=1e-9)
+    assert np.isclose(points[:, 1].max(), 100.0)
+
+
+def test_intersection_curves_of_many_pairs(flat_grid, wall):
+    meshes = [
+        numpy_mesh(*flat_grid),
+        numpy_mesh(*wall(x0=45.0)),
+        numpy_mesh(*wall(y0=30.0)),
+        numpy_mesh(*wall(x0=1000.0)),
+    ]
+
+    lines = loop_cgal.intersection_curves(
+        meshes, [(0, 1), (0, 2), (1, 2), (0, 3)]
+    )
+
+    points, ids = _rows(lines)
+    # The far wall meets nothing
+    assert set(ids.tolist()) == {0, 1, 2}
+    np.testing.assert_allclose(points[ids == 0, 0], 45.0, atol=1e-9)
+    np.testing.assert_allclose(points[ids == 1, 1], 30.0, atol=1e-9)
+    # The two walls cross along the vertical x = 45, y = 30
+    np.testing.assert_allclose(points[ids == 2, :2], [[45.0, 30.0]], atol=1e-9)
+    assert np.isclose(points[ids == 2, 2].min(), -10.0)
+    assert np.isclose(points[ids == 2, 2].max(), 10.0)
+
+
+def test_intersection_curves_reject_bad_pairs(flat_grid, wall):
+    meshes = [numpy_mesh(*flat_grid), numpy_mesh(*wall(x0=45.0))]
+
+    with pytest.raises(ValueError):
+        loop_cgal.intersection_curves(meshes, [(0, 2)])
@@ -0,0 +1,86 @@
+from __future__ import annotations
+
+import logging
+
+import pytest
+from conftest import numpy_mesh
+
+import loop_cgal
+
+
+@pytest.fixture(autouse=True)
+def log_level():
+    level = loop_cgal.get_log_level()
+    loop_cgal.drain_log()
+    yield
+    loop_cgal.set_log_level(level)
+    loop_cgal.drain_log()
+
+
+def _clip(flat_grid, wall, **kwargs):
+    loop_cgal.clip_surface(
+        numpy_mesh(*flat_grid),
+        numpy_mesh(*wall(x0=45.0)),
+        target_edge_length=5.0,
+        **kwargs,
+    )
+
+
+def _levels(records) -> set:
+    return {level for level, _ in records}
+
+
+def test_default_level_buffers_no_debug_records(flat_grid, wall):
+    assert loop_cgal.get_log_level() == loop_cgal.LogLevel.WARNING
+
+    _clip(flat_grid, wall)
+
+    assert loop_cgal.LogLevel.DEBUG not in _levels(loop_cgal.drain_log())
+
+
+def test_verbose_call_logs_debug_for_that_call_only(flat_grid, wall):
+    _clip(flat_grid, wall, verbose=True)
+
+    assert loop_cgal.LogLevel.DEBUG in _levels(loop_cgal.drain_log())
+    assert loop_cgal.get_log_level() == loop_cgal.LogLevel.WARNING
+    _clip(flat_grid, wall)
+    assert loop_cgal.LogLevel.DEBUG not in _levels(loop_cgal.drain_log())
+
+
+def test_set_log_level_applies_to_every_call(flat_grid, wall):
+    loop_cgal.set_log_level(loop_cgal.LogLevel.DEBUG)
+
+    _clip(flat_grid, wall)
+
+    assert loop_cgal.LogLevel.DEBUG in _levels(loop_cgal.drain_log())
+
+
+def test_drain_log_empties_the_buffer(flat_grid, wall):
+    _clip(flat_grid, wall, verbose=True)
+
+    assert loop_cgal.drain_log()
+    assert loop_cgal.drain_log() == []
+
+
+def test_forward_log_sends_records_to_a_logger(flat_grid, wall, caplog):
+    target = logging.getLogger("loop_cgal.test")
+    _clip(flat_grid, wall, verbose=True)
+
+    with caplog.at_level(logging.DEBUG, logger=target.name):
+        n = loop_cgal.forward_log(target)
+
+    assert n > 0
+    assert len(caplog.records) == n
+    assert loop_cgal.drain_log() == []
+
+
+def test_verbose_flag_is_a_deprecated_alias_of_the_level():
+    with pytest.deprecated_call():
+        loop_cgal.verbose = True
+    assert loop_cgal.get_log_level() == loop_cgal.LogLevel.DEBUG
+    with pytest.deprecated_call():
+        assert loop_cgal.verbose
+
+    with pytest.deprecated_call():
+        loop_cgal.verbose = False
+    assert loop_cgal.get_log_level() == loop_cgal.LogLevel.WARNING
@@ -0,0 +1,73 @@
+from __future__ import annotations
+
+import pytest
+from conftest import numpy_mesh
+
+import loop_cgal
+
+_ENABLED = loop_cgal.memory_stats()["enabled"]
+
+
+@pytest.fixture(autouse=True)
+def no_reports():
+    loop_cgal.drain_memory_reports()
+    yield
+    loop_cgal.drain_memory_reports()
+
+
+def _clip(flat_grid, wall):
+    return loop_cgal.clip_surface(
+        numpy_mesh(*flat_grid), numpy_mesh(*wall(x0=45.0)), target_edge_length=5.0
+    )
+
+
+def test_memory_stats_fields():
+    stats = loop_cgal.memory_stats()
+
+    assert set(stats) == {"enabled", "live", "peak"}
+    assert isinstance(stats["enabled"], bool)
+    if not stats["enabled"]:
+        assert stats["live"] == stats["peak"] == 0
+    else:
+        assert 0 <= stats["live"] <= stats["peak"]
+
+
+def test_each_call_leaves_one_report(flat_grid, wall):
+    _clip(flat_grid, wall)
+
+    reports = loop_cgal.drain_memory_reports()
+
+    assert [report["call"] for report in reports] == ["clip_surface"]
+    report = reports[0]
+    names = [phase["name"] for phase in report["phases"]]
+    assert names[0] == "load" and names[-1] == "export" and "clip" in names
+    for entry in [report] + report["phases"]:
+        assert entry["peak"] >= max(entry["start"], entry["end"])
+    assert loop_cgal.drain_memory_reports() == []
+
+
+def test_trimesh_calls_are_reported(flat_grid):
+    mesh = loop_cgal.TriMesh(numpy_mesh(*flat_grid))
+    mesh.remesh(target_edge_length=5.0, number_of_iterations=1)
+    mesh.save()
+
+    calls = [report["call"] for report in loop_cgal.drain_memory_reports()]
+
+    assert calls == ["TriMesh", "TriMesh.remesh", "TriMesh.save"]
+
+
+def test_only_the_latest_reports_are_kept(flat_grid):
+    mesh = loop_cgal.TriMesh(numpy_mesh(*flat_grid))
+    for _ in range(70):
+        mesh.save()
+
+    assert len(loop_cgal.drain_memory_reports()) == 64
+
+
+@pytest.mark.skipif(not _ENABLED, reason="built without memory accounting")
+def test_peak_covers_the_work_of_a_call(flat_grid, wall):
+    _clip(flat_grid, wall)
+
+    (report,) = loop_cgal.drain_memory_reports()
+    assert report["peak"] > report["start"]
+    assert loop_cgal.memory_stats()["peak"] >= loop_cgal.memory_stats()["live"]
@@ -0,0 +1,40 @@
+from __future__ import annotations
+
+import numpy as np
+import pytest
+from conftest import numpy_mesh
+
+import loop_cgal
+
+
+def _partition(flat_grid, clippers):
+    vertices, triangles = flat_grid
+    mesh, labels = loop_cgal.partition_surface(
+        numpy_mesh(vertices, triangles),
+        [numpy_mesh(*clipper) for clipper in clippers],
+        target_edge_length=5.0,
+        remesh_before_partition=False,
+    )
+    labels = np.asarray(labels)
+    assert len(labels) == mesh.n_triangles
+    return labels
+
+
+@pytest.mark.parametrize(
+    ("walls", "n_blocks"),
+    [
+        ([], 1),
+        ([{"x0": 33.3}], 2),
+        # disjoint clippers, corefined together in one pass
+        ([{"x0": 33.3}, {"x0": 66.7}], 3),
+        # crossing clippers
+        ([{"x0": 33.3}, {"x0": 66.7}, {"y0": 55.5}], 6),
+        # a clipper away from the surface changes nothing
+        ([{"x0": 33.3}, {"x0": 500.0}], 2),
+    ],
+)
+def test_partition_label_counts(flat_grid, wall, walls, n_blocks):
+    labels = _partition(flat_grid, [wall(**w) for w in walls])
+
+    assert len(np.unique(labels)) == n_blocks
+    assert set(np.unique(labels).tolist()) == set(range(n_blocks))
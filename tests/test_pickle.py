@@ -0,0 +1,34 @@
+from __future__ import annotations
+
+import pickle
+
+import numpy as np
+from conftest import canonical, numpy_mesh
+
+import loop_cgal
+
+
+def test_trimesh_pickle_round_trip(flat_grid):
+    vertices, triangles = flat_grid
+    mesh = loop_cgal.TriMesh(numpy_mesh(vertices, triangles))
+    mesh.fix_new_borders = True
+
+    copy = pickle.loads(pickle.dumps(mesh))
+
+    assert copy.fix_new_borders
+    before, after = mesh.save(), copy.save()
+    np.testing.assert_array_equal(after.vertices, before.vertices)
+    np.testing.assert_array_equal(
+        canonical(after.triangles), canonical(before.triangles)
+    )
+
+
+
+def test_trimesh_state_is_the_binary_snapshot(flat_grid):
+    mesh = loop_cgal.TriMesh(numpy_mesh(*flat_grid))
+
+    state = mesh.__getstate__()
+
+    assert isinstance(state, bytes)
+    assert state[:4] == b"LCTM"
+    assert not pickle.loads(pickle.dumps(mesh)).fix_new_borders
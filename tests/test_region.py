@@ -0,0 +1,164 @@
+from __future__ import annotations
+
+import numpy as np
+from conftest import numpy_mesh
+
+import loop_cgal
+
+_NO_REMESH = dict(
+    remesh_before_clipping=False,
+    remesh_after_clipping=False,
+    remove_degenerate_faces=False,
+)
+_NOT_MERGED = "Clip region cannot be merged; clipping the whole mesh."
+
+
+def _clip(surface, clipper, **kwargs):
+    """Clip result and the log messages of the call."""
+    loop_cgal.drain_log()
+    result = loop_cgal.clip_surface(
+        numpy_mesh(*surface), numpy_mesh(*clipper), verbose=True, **kwargs
+    )
+    return result, [message for _, message in loop_cgal.drain_log()]
+
+
+def _fallbacks(messages):
+    return [m for m in messages if m.endswith("clipping the whole mesh.")]
+
+
+def _corners(vertices, triangles) -> list:
+    """Each triangle as its sorted corner coordinates."""
+    corners = np.asarray(vertices)[np.asarray(triangles).reshape(-1, 3)]
+    return [tuple(sorted(map(tuple, triangle))) for triangle in corners.tolist()]
+
+
+def _faces(mesh) -> list:
+    """Sorted triangles of mesh, compared up to round-off."""
+    vertices = np.round(np.asarray(mesh.vertices), 9)
+    return sorted(_corners(vertices, mesh.triangles))
+
+
+def _with_far_copy(vertices, triangles):
+    """The surface plus a copy of it 200 above, away from any clipper."""
+    far = vertices + np.array([0.0, 0.0, 200.0])
+    return (
+        np.vstack([vertices, far]),
+        np.vstack([triangles, triangles + len(vertices)]),
+    )
+
+
+def _area(mesh) -> float:
+    corners = np.asarray(mesh.vertices)[np.asarray(mesh.triangles).reshape(-1, 3)]
+    normals = np.cross(corners[:, 1] - corners[:, 0], corners[:, 2] - corners[:, 0])
+    return 0.5 * float(np.linalg.norm(normals, axis=1).sum())
+
+
+def _untouched(flat_grid, result, keep):
+    """Whether the grid triangles whose corners all pass keep(x) are in
+    result with bit-identical coordinates."""
+    vertices, triangles = flat_grid
+    far = triangles[np.all(keep(vertices[triangles][:, :, 0]), axis=1)]
+    assert len(far) > 0
+    out = set(_corners(result.vertices, result.triangles))
+    return all(face in out for face in _corners(vertices, far))
+
+
+def test_region_clip_matches_whole_clip(flat_grid, wall):
+    clipper = wall(x0=45.0)
+
+    region, messages = _clip(
+        flat_grid, clipper, target_edge_length=5.0, region_of_interest=True,
+        **_NO_REMESH,
+    )
+    whole, _ = _clip(flat_grid, clipper, target_edge_length=5.0, **_NO_REMESH)
+
+    assert any(m.startswith("Clip region holds") for m in messages)
+    assert not _fallbacks(messages)
+    assert _faces(region) == _faces(whole)
+
+
+def test_faces_away_from_the_clipper_pass_through(flat_grid, wall):
+    region, messages = _clip(
+        flat_grid, wall(x0=45.0), target_edge_length=5.0,
+        region_of_interest=True,
+    )
+
+    assert not _fallbacks(messages)
+    # The roi spans x in [30, 60]; the faces along its seam may be split
+    assert _untouched(flat_grid, region, lambda x: x <= 20.0)
+
+
+def test_missed_clipper_keeps_the_remeshed_region(flat_grid, wall):
+    vertices, triangles = wall(x0=45.0)
+    # Above the grid, but its box with the margin still overlaps it
+    above = (vertices + np.array([0.0, 0.0, 15.0]), triangles)
+
+    region, messages = _clip(
+        flat_grid, above, target_edge_length=5.0, region_of_interest=True
+    )
+
+    assert not _fallbacks(messages)
+    assert "Meshes do not intersect. Returning tm." in messages
+    assert np.isclose(_area(region), 100.0 * 100.0)
+    assert _untouched(flat_grid, region, lambda x: x <= 20.0)
+    assert _untouched(flat_grid, region, lambda x: x >= 70.0)
+
+
+def test_no_proper_region_clips_the_whole_mesh(flat_grid, wall):
+    clipper = wall(x0=45.0)
+
+    # The margin of two target edges around the clipper covers the grid
+    region, messages = _clip(
+        flat_grid, clipper, target_edge_length=60.0, region_of_interest=True,
+        **_NO_REMESH,
+    )
+    whole, _ = _clip(flat_grid, clipper, target_edge_length=60.0, **_NO_REMESH)
+
+    assert "No proper clip region; clipping the whole mesh." in messages
+    assert _faces(region) == _faces(whole)
+
+
+def test_rest_on_both_sides_of_the_cut_clips_the_whole_mesh(tube, wall):
+    clipper = wall(x0=45.0)
+
+    # The wall cuts the bottom of the tube only, and the top joins the
+    # faces kept on one side to the faces clipped on the other
+    region, messages = _clip(
+        tube, clipper, target_edge_length=5.0, region_of_interest=True,
+        **_NO_REMESH,
+    )
+    whole, _ = _clip(tube, clipper, target_edge_length=5.0, **_NO_REMESH)
+
+    assert _NOT_MERGED in messages
+    assert _faces(region) == _faces(whole)
+
+
+def test_open_clipper_with_a_detached_component_clips_the_whole_mesh(
+    flat_grid, wall
+):
+    surface = _with_far_copy(*flat_grid)
+    clipper = wall(x0=45.0)
+
+    region, messages = _clip(
+        surface, clipper, target_edge_length=5.0, region_of_interest=True,
+        **_NO_REMESH,
+    )
+    whole, _ = _clip(surface, clipper, target_edge_length=5.0, **_NO_REMESH)
+
+    assert _NOT_MERGED in messages
+    assert _faces(region) == _faces(whole)
+
+
+def test_closed_clipper_drops_detached_components(flat_grid, box):
+    surface = _with_far_copy(*flat_grid)
+    clipper = box(43.0, 57.0, -10.0, 110.0, -10.0, 10.0)
+
+    region, messages = _clip(
+        surface, clipper, target_edge_length=5.0, region_of_interest=True,
+        **_NO_REMESH,
+    )
+    whole, _ = _clip(surface, clipper, target_edge_length=5.0, **_NO_REMESH)
+
+    assert not _fallbacks(messages)
+    assert np.all(np.asarray(region.vertices)[:, 2] < 100.0)
+    assert _faces(region) == _faces(whole)
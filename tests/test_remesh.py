@@ -0,0 +1,44 @@
+from __future__ import annotations
+
+from conftest import numpy_mesh
+
+import loop_cgal
+
+
+def _grid(flat_grid) -> loop_cgal.TriMesh:
+    return loop_cgal.TriMesh(numpy_mesh(*flat_grid))
+
+
+def test_zero_tolerance_runs_every_iteration(flat_grid):
+    mesh = _grid(flat_grid)
+
+    assert mesh.remesh(
+        target_edge_length=5.0, number_of_iterations=4, convergence_tolerance=0.0
+    ) == 4
+
+
+def test_loose_tolerance_stops_after_one_iteration(flat_grid):
+    mesh = _grid(flat_grid)
+
+    # Every statistic changes by far less than ten times its value
+    assert mesh.remesh(
+        target_edge_length=5.0, number_of_iterations=10, convergence_tolerance=10.0
+    ) == 1
+
+
+def test_settled_mesh_stops_before_the_iteration_cap(flat_grid):
+    mesh = _grid(flat_grid)
+    mesh.remesh(target_edge_length=5.0, number_of_iterations=3)
+    n_before = mesh.save().n_triangles
+
+    n_iterations = mesh.remesh(target_edge_length=5.0, number_of_iterations=20)
+
+    assert 1 <= n_iterations < 20
+    assert abs(mesh.save().n_triangles - n_before) <= 0.05 * n_before
+
+
+def test_too_short_target_skips_the_remesh(flat_grid):
+    mesh = _grid(flat_grid)
+
+    assert mesh.remesh(target_edge_length=1e-6) == 0
+    assert mesh.save().n_triangles == len(flat_grid[1])
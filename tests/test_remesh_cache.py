@@ -0,0 +1,67 @@
+from __future__ import annotations
+
+import numpy as np
+import pytest
+from conftest import numpy_mesh
+
+import loop_cgal
+
+
+def _clip(vertices, triangles, clipper):
+    return loop_cgal.clip_surface(
+        numpy_mesh(vertices, triangles),
+        numpy_mesh(*clipper),
+        target_edge_length=7.0,
+        remesh_before_clipping=True,
+    )
+
+
+@pytest.mark.usefixtures("remesh_cache")
+def test_cache_hit_reproduces_the_miss(flat_grid, wall):
+    vertices, triangles = flat_grid
+    clipper = wall(x0=45.0)
+
+    first = _clip(vertices, triangles, clipper)
+    # Same values in another dtype and layout: still a hit
+    second = _clip(vertices.astype(np.float32), triangles.astype(np.int32), clipper)
+
+    stats = loop_cgal.remesh_cache_stats()
+    assert stats["misses"] == 1
+    assert stats["hits"] == 1
+    np.testing.assert_array_equal(second.vertices, first.vertices)
+    np.testing.assert_array_equal(second.triangles, first.triangles)
+
+
+@pytest.mark.usefixtures("remesh_cache")
+def test_changed_input_misses(flat_grid, wall):
+    vertices, triangles = flat_grid
+    clipper = wall(x0=45.0)
+    _clip(vertices, triangles, clipper)
+
+    moved = vertices.copy()
+    moved[0, 2] += 1e-3
+    _clip(moved, triangles, clipper)
+
+    stats = loop_cgal.remesh_cache_stats()
+    assert stats["misses"] == 2
+    assert stats["hits"] == 0
+
+
+@pytest.mark.usefixtures("remesh_cache")
+def test_region_fallback_leaves_the_cache_to_whole_clips(tube, wall):
+    surface, clipper = numpy_mesh(*tube), numpy_mesh(*wall(x0=45.0))
+
+    def clip(**kwargs):
+        return loop_cgal.clip_surface(
+            surface, clipper, target_edge_length=5.0, **kwargs
+        )
+
+    # The tube joins both sides of the cut, so the region clip falls back to
+    # a whole clip after splitting its seam edges
+    clip(region_of_interest=True)
+    after_fallback = clip()
+    loop_cgal.clear_remesh_cache()
+    fresh = clip()
+
+    np.testing.assert_array_equal(after_fallback.vertices, fresh.vertices)
+    np.testing.assert_array_equal(after_fallback.triangles, fresh.triangles)
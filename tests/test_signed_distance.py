@@ -0,0 +1,70 @@
+from __future__ import annotations
+
+import threading
+
+import numpy as np
+from conftest import numpy_mesh
+
+import loop_cgal
+
+
+def test_sign_at_ridge_edges_and_vertices(roof):
+    vertices, triangles = roof
+    mesh = loop_cgal.TriMesh(numpy_mesh(vertices, triangles))
+    # Above the ridge x = 0, along directions between the two face normals
+    # (+-3, 0, 1) but past each of them, so the closest point is on the
+    # ridge and the far face's normal points away from the query point.
+    # Even y hit ridge vertices, odd y the ridge edges between them.
+    ys = np.linspace(2.0, 18.0, 17)
+    above = np.concatenate(
+        [np.column_stack([np.full_like(ys, x), ys, np.full_like(ys, 1.5)]) for x in (3.0, -3.0)]
+    )
+
+    distance = np.asarray(mesh.signed_distance(above))
+
+    np.testing.assert_allclose(distance, np.sqrt(3.0**2 + 1.5**2))
+
+
+def test_sign_inside_and_outside(roof):
+    vertices, triangles = roof
+    mesh = loop_cgal.TriMesh(numpy_mesh(vertices, triangles))
+    points = np.array(
+        [
+            [0.0, 10.0, 1.0],  # above the ridge
+            [0.0, 10.0, -1.0],  # below it, closest to a face
+            [5.0, 10.0, -20.0],  # below a face
+            [-5.0, 10.0, 0.0],  # above a face
+        ]
+    )
+
+    distance = np.asarray(mesh.signed_distance(points))
+
+    np.testing.assert_array_equal(np.sign(distance), [1, -1, -1, 1])
+
+
+def test_queries_while_another_thread_clips(flat_grid):
+    mesh = loop_cgal.TriMesh(numpy_mesh(*flat_grid))
+    rng = np.random.default_rng(0)
+    points = rng.uniform([0.0, 0.0, 1.0], [100.0, 100.0, 10.0], size=(20000, 3))
+    errors = []
+
+    def query():
+        try:
+            for _ in range(10):
+                distance = np.asarray(mesh.signed_distance(points))
+                assert np.all(np.isfinite(distance) & (distance > 0))
+        except Exception as error:  # reported below
+            errors.append(error)
+
+    threads = [threading.Thread(target=query) for _ in range(3)]
+    for thread in threads:
+        thread.start()
+    for x in (90.0, 75.0, 60.0):
+        mesh.clip_plane(np.array([1.0, 0.0, 0.0]), np.array([x, 0.0, 0.0]))
+    for thread in threads:
+        thread.join()
+
+    assert not errors
+    # Points over what is left of the grid are their height above it
+    over = points[points[:, 0] < 60.0]
+    np.testing.assert_allclose(mesh.signed_distance(over), over[:, 2])
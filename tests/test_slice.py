@@ -0,0 +1,47 @@
+from __future__ import annotations
+
+import numpy as np
+from conftest import numpy_mesh
+
+import loop_cgal
+
+
+def _plane(origin, normal):
+    plane = loop_cgal.NumpyPlane()
+    plane.origin = np.asarray(origin, dtype=np.float64)
+    plane.normal = np.asarray(normal, dtype=np.float64)
+    return plane
+
+
+def test_slice_planes_cross_sections(flat_grid):
+    vertices, triangles = flat_grid
+    planes = [_plane([50.5, 0, 0], [1, 0, 0]), _plane([0, 20.5, 0], [0, 1, 0])]
+
+    lines = loop_cgal.slice_planes(numpy_mesh(vertices, triangles), planes)
+
+    points = np.asarray(lines.vertices)
+    offsets = np.asarray(lines.offsets)
+    ids = np.asarray(lines.ids)
+    assert offsets[0] == 0
+    assert offsets[-1] == len(points)
+    assert len(ids) == len(offsets) - 1
+    assert set(ids.tolist()) == {0, 1}
+    row_ids = np.repeat(ids, np.diff(offsets))
+    np.testing.assert_allclose(points[:, 2], 0.0, atol=1e-9)
+    # Each section lies in its plane and spans the whole square
+    np.testing.assert_allclose(points[row_ids == 0, 0], 50.5, atol=1e-9)
+    np.testing.assert_allclose(points[row_ids == 1, 1], 20.5, atol=1e-9)
+    for plane_id, along in ((0, 1), (1, 0)):
+        coords = points[row_ids == plane_id, along]
+        assert np.isclose(coords.min(), 0.0, atol=1e-9)
+        assert np.isclose(coords.max(), 100.0)
+
+
+def test_slice_planes_missing_plane(flat_grid):
+    vertices, triangles = flat_grid
+
+    lines = loop_cgal.slice_planes(
+        numpy_mesh(vertices, triangles), [_plane([0, 0, 50], [0, 0, 1])]
+    )
+
+    assert len(np.asarray(lines.ids)) == 0
@@ -0,0 +1,64 @@
+from __future__ import annotations
+
+import numpy as np
+import pytest
+from conftest import numpy_mesh
+
+import loop_cgal
+
+
+@pytest.fixture
+def spatial_ordering():
+    previous = loop_cgal.get_spatial_ordering()
+    yield loop_cgal.set_spatial_ordering
+    loop_cgal.set_spatial_ordering(previous)
+
+
+def _export(flat_grid, wall):
+    """flat_grid through a clip that misses it, with a vertex attribute."""
+    vertices, triangles = flat_grid
+    mesh = numpy_mesh(vertices, triangles)
+    mesh.vertex_attributes = {"row": np.arange(len(vertices), dtype=np.float64)}
+    return loop_cgal.clip_surface(
+        mesh,
+        numpy_mesh(*wall(x0=1000.0)),
+        remesh_before_clipping=False,
+        remesh_after_clipping=False,
+        remove_degenerate_faces=False,
+    )
+
+
+def _triangle_corners(mesh) -> list:
+    corners = np.asarray(mesh.vertices)[np.asarray(mesh.triangles).reshape(-1, 3)]
+    return sorted(tuple(sorted(map(tuple, t))) for t in corners.tolist())
+
+
+def test_hilbert_order_is_a_permutation(flat_grid, wall, spatial_ordering):
+    spatial_ordering(False)
+    plain = _export(flat_grid, wall)
+    spatial_ordering(True)
+    ordered = _export(flat_grid, wall)
+
+    plain_vertices = np.asarray(plain.vertices)
+    ordered_vertices = np.asarray(ordered.vertices)
+    assert ordered_vertices.shape == plain_vertices.shape
+    assert not np.array_equal(ordered_vertices, plain_vertices)
+    # Same points and triangles, in another order
+    np.testing.assert_array_equal(
+        np.unique(ordered_vertices, axis=0), np.unique(plain_vertices, axis=0)
+    )
+    assert _triangle_corners(ordered) == _triangle_corners(plain)
+    # Attributes move with their vertices
+    input_vertices = flat_grid[0]
+    rows = np.rint(ordered.vertex_attributes["row"]).astype(np.int64)
+    np.testing.assert_array_equal(input_vertices[rows], ordered_vertices)
+
+
+def test_hilbert_order_keeps_the_orientation(flat_grid, wall, spatial_ordering):
+    spatial_ordering(True)
+    ordered = _export(flat_grid, wall)
+
+    corners = np.asarray(ordered.vertices)[np.asarray(ordered.triangles).reshape(-1, 3)]
+    normals = np.cross(corners[:, 1] - corners[:, 0], corners[:, 2] - corners[:, 0])
+    # flat_grid faces +z
+    assert np.all(normals[:, 2] > 0.0)
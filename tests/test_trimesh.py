@@ -0,0 +1,104 @@
+from __future__ import annotations
+
+import numpy as np
+import pytest
+from conftest import numpy_mesh
+
+import loop_cgal
+
+_CUT_X = 45.0
+
+
+def _border_edges(mesh: loop_cgal.NumpyMesh) -> np.ndarray:
+    """(n, 2) vertex pairs of the edges with a single incident triangle."""
+    triangles = np.asarray(mesh.triangles).reshape(-1, 3)
+    edges = np.sort(
+        np.concatenate(
+            [triangles[:, [0, 1]], triangles[:, [1, 2]], triangles[:, [2, 0]]]
+        ),
+        axis=1,
+    )
+    unique, counts = np.unique(edges, axis=0, return_counts=True)
+    return unique[counts == 1]
+
+
+def _border_counts(trimesh: loop_cgal.TriMesh) -> tuple[int, int]:
+    """Numbers of border edges off and on the clip line x = _CUT_X."""
+    saved = trimesh.save()
+    x = np.asarray(saved.vertices)[:, 0]
+    on_cut = np.all(np.isclose(x[_border_edges(saved)], _CUT_X), axis=1)
+    return int(np.count_nonzero(~on_cut)), int(np.count_nonzero(on_cut))
+
+
+def _clipped(flat_grid, fix_new_borders):
+    mesh = loop_cgal.TriMesh(numpy_mesh(*flat_grid))
+    mesh.fix_new_borders = fix_new_borders
+    mesh.clip_plane(np.array([1.0, 0.0, 0.0]), np.array([_CUT_X, 0.0, 0.0]))
+    return mesh
+
+
+@pytest.mark.parametrize("fix_new_borders", [False, True])
+def test_clip_plane_fixes_the_clip_line_only_on_request(
+    flat_grid, fix_new_borders
+):
+    mesh = _clipped(flat_grid, fix_new_borders)
+
+    outer, cut = _border_counts(mesh)
+    assert cut > 0
+    assert mesh.n_fixed_edges == (outer + cut if fix_new_borders else outer)
+
+
+def test_clip_line_stays_free_through_a_remesh(flat_grid):
+    mesh = _clipped(flat_grid, fix_new_borders=False)
+
+    mesh.remesh(target_edge_length=2.5, number_of_iterations=2)
+
+    outer, cut = _border_counts(mesh)
+    assert cut > 0
+    # Only the pieces of the original border edges are fixed
+    assert mesh.n_fixed_edges == outer
+
+
+def test_corefine_fixes_the_intersection_in_both_meshes(flat_grid, wall):
+    mesh = loop_cgal.TriMesh(numpy_mesh(*flat_grid))
+    other = loop_cgal.TriMesh(numpy_mesh(*wall(x0=_CUT_X)))
+    n_mesh, n_other = mesh.n_fixed_edges, other.n_fixed_edges
+
+    mesh.corefine(other)
+
+    outer, cut = _border_counts(mesh)
+    assert cut == 0  # corefine splits the faces but keeps both sides
+    assert mesh.n_fixed_edges > n_mesh == outer
+    assert other.n_fixed_edges > n_other
+    assert mesh.save().n_triangles > len(flat_grid[1])
+
+
+def test_stitch_joins_a_split_grid(flat_grid):
+    vertices, triangles = flat_grid
+    # Give the faces right of x = 50 their own copy of the seam vertices
+    right = vertices[triangles].mean(axis=1)[:, 0] > 50.0
+    seam = np.flatnonzero(np.isclose(vertices[:, 0], 50.0))
+    copy = np.arange(len(vertices))
+    copy[seam] = len(vertices) + np.arange(len(seam))
+    split = triangles.copy()
+    split[right] = copy[triangles[right]]
+    mesh = loop_cgal.TriMesh(numpy_mesh(np.vstack([vertices, vertices[seam]]), split))
+    assert len(_border_edges(mesh.save())) == 40 + 2 * 10
+
+    mesh.stitch()
+
+    saved = mesh.save()
+    assert len(saved.vertices) == len(vertices)
+    assert len(_border_edges(saved)) == 40
+    # The stitched seam keeps the constraint its border edges had
+    assert mesh.n_fixed_edges == 40 + 10
+
+
+def test_remove_degenerate_faces_keeps_a_clean_mesh(flat_grid):
+    mesh = loop_cgal.TriMesh(numpy_mesh(*flat_grid))
+    n_fixed = mesh.n_fixed_edges
+
+    assert mesh.remove_degenerate_faces()
+
+    assert mesh.save().n_triangles == len(flat_grid[1])
+    assert mesh.n_fixed_edges == n_fixed
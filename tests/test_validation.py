@@ -0,0 +1,69 @@
+from __future__ import annotations
+
+import numpy as np
+import pytest
+from conftest import canonical, numpy_mesh
+
+import loop_cgal
+
+
+@pytest.fixture(autouse=True)
+def validation_level():
+    level = loop_cgal.get_validation_level()
+    yield
+    loop_cgal.set_validation_level(level)
+
+
+def _clip(flat_grid, wall):
+    return loop_cgal.clip_surface(
+        numpy_mesh(*flat_grid), numpy_mesh(*wall(x0=45.0)), target_edge_length=5.0
+    )
+
+
+def test_inputs_only_is_the_default():
+    assert loop_cgal.get_validation_level() == loop_cgal.ValidationLevel.INPUTS_ONLY
+
+
+@pytest.mark.parametrize(
+    "level",
+    [
+        loop_cgal.ValidationLevel.OFF,
+        loop_cgal.ValidationLevel.INPUTS_ONLY,
+        loop_cgal.ValidationLevel.PARANOID,
+    ],
+)
+def test_level_round_trips(level):
+    loop_cgal.set_validation_level(level)
+
+    assert loop_cgal.get_validation_level() == level
+
+
+@pytest.mark.parametrize(
+    "level", [loop_cgal.ValidationLevel.OFF, loop_cgal.ValidationLevel.PARANOID]
+)
+def test_level_does_not_change_the_result(flat_grid, wall, level):
+    expected = _clip(flat_grid, wall)
+
+    loop_cgal.set_validation_level(level)
+    result = _clip(flat_grid, wall)
+
+    np.testing.assert_array_equal(result.vertices, expected.vertices)
+    np.testing.assert_array_equal(
+        canonical(result.triangles), canonical(expected.triangles)
+    )
+
+
+def test_paranoid_checks_log_nothing_for_valid_meshes(flat_grid, wall):
+    loop_cgal.set_validation_level(loop_cgal.ValidationLevel.PARANOID)
+    loop_cgal.drain_log()
+
+    loop_cgal.clip_surface(
+        numpy_mesh(*flat_grid),
+        numpy_mesh(*wall(x0=45.0)),
+        target_edge_length=5.0,
+        verbose=True,
+    )
+
+    messages = [message for _, message in loop_cgal.drain_log()]
+    assert messages
+    assert not any("not a valid polygon mesh" in m for m in messages)